@@ -0,0 +1,83 @@
+//
+// Created by Pascal Charpentier on 2023-06-20.
+//
+
+#include "ArenaArcs.h"
+
+/**
+ * Construit une arène vide.  Aucune mémoire n'est réservée avant la première allocation.
+ * @param tailleBloc Nombre d'octets réservés à chaque fois que l'arène doit s'agrandir.
+ */
+ArenaArcs::ArenaArcs(size_t tailleBloc) : tailleBloc(arrondir(tailleBloc)), blocs(), reserves(0), courant(nullptr),
+                                          restant(0), tailleRecyclee(0), libres(nullptr) {
+}
+
+/**
+ * Arrondit un nombre d'octets au multiple supérieur de l'alignement fondamental, de sorte que tout découpage d'un bloc
+ * reste correctement aligné.
+ * @param octets Nombre d'octets demandés
+ * @return Nombre d'octets effectivement utilisés dans le bloc
+ */
+size_t ArenaArcs::arrondir(size_t octets) {
+    const size_t alignement = alignof(std::max_align_t) ;
+    if (octets < sizeof(NoeudLibre)) octets = sizeof(NoeudLibre) ;
+    return (octets + alignement - 1) / alignement * alignement ;
+}
+
+/**
+ * Fournit une zone mémoire d'une taille donnée.  Une zone libérée de même taille est réutilisée en priorité, sinon la
+ * zone est découpée dans le bloc courant.  Une demande plus grande qu'un bloc reçoit son propre bloc.
+ * @param octets Nombre d'octets voulus
+ * @return Adresse d'une zone alignée sur l'alignement fondamental
+ */
+void* ArenaArcs::allouer(size_t octets) {
+    octets = arrondir(octets) ;
+    if (tailleRecyclee == 0) tailleRecyclee = octets ;
+
+    if (octets == tailleRecyclee && libres != nullptr) {
+        NoeudLibre* zone = libres ;
+        libres = libres->suivant ;
+        return zone ;
+    }
+
+    if (octets > restant) {
+        size_t taille = octets > tailleBloc ? octets : tailleBloc ;
+        blocs.emplace_back(new char[taille]) ;
+        reserves += taille ;
+        courant = blocs.back().get() ;
+        restant = taille ;
+    }
+
+    void* zone = courant ;
+    courant += octets ;
+    restant -= octets ;
+    return zone ;
+}
+
+/**
+ * Rend une zone à l'arène.  Les zones de la taille de la première allocation (celle des noeuds de liste) sont chaînées
+ * pour être recyclées, les autres ne seront récupérées qu'à la destruction de l'arène.
+ * @param adresse Zone obtenue par allouer
+ * @param octets La taille demandée lors de l'allocation
+ */
+void ArenaArcs::liberer(void* adresse, size_t octets) {
+    if (arrondir(octets) != tailleRecyclee) return ;
+
+    auto zone = static_cast<NoeudLibre*>(adresse) ;
+    zone->suivant = libres ;
+    libres = zone ;
+}
+
+/**
+ * @return Le nombre de blocs réservés auprès de l'allocateur global depuis la construction de l'arène.
+ */
+size_t ArenaArcs::nombreBlocs() const {
+    return blocs.size() ;
+}
+
+/**
+ * @return Le nombre total d'octets réservés par l'arène.
+ */
+size_t ArenaArcs::octetsReserves() const {
+    return reserves ;
+}
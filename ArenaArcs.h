@@ -0,0 +1,106 @@
+//
+// Created by Pascal Charpentier on 2023-06-20.
+//
+
+#ifndef SIMPLESGRAPHES_ARENAARCS_H
+#define SIMPLESGRAPHES_ARENAARCS_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class ArenaArcs
+ *
+ * Arène d'allocation servant à emmagasiner les noeuds des listes d'adjacence d'un ou de plusieurs graphes.  Plutôt que
+ * de demander chaque noeud à l'allocateur global, l'arène réserve de gros blocs de mémoire et les découpe au besoin.
+ * Les noeuds libérés (par exemple lors d'un retirerArc) sont recyclés par une liste de blocs libres; le reste de la
+ * mémoire n'est rendu au système qu'à la destruction de l'arène, en quelques désallocations seulement.
+ *
+ * Une même arène peut être partagée par plusieurs graphes, par exemple des graphes temporaires construits le temps
+ * d'une requête.  ATTENTION: l'arène n'est pas protégée contre les accès concurrents.
+ */
+class ArenaArcs {
+public:
+    explicit ArenaArcs(size_t tailleBloc = 64 * 1024) ;
+
+    ArenaArcs(const ArenaArcs&) = delete ;
+    ArenaArcs& operator = (const ArenaArcs&) = delete ;
+
+    void*  allouer(size_t octets) ;
+
+    void   liberer(void* adresse, size_t octets) ;
+
+    size_t nombreBlocs()                                       const ;
+
+    size_t octetsReserves()                                    const ;
+
+private:
+    struct NoeudLibre {
+        NoeudLibre* suivant ;
+    };
+
+    static size_t arrondir(size_t octets) ;
+
+    size_t                               tailleBloc ;
+    std::vector<std::unique_ptr<char[]>> blocs ;
+    size_t                               reserves ;
+    char*                                courant ;
+    size_t                               restant ;
+    size_t                               tailleRecyclee ;
+    NoeudLibre*                          libres ;
+};
+
+/**
+ * @class AllocateurArcs
+ *
+ * Allocateur conforme à la norme, utilisé par les listes d'adjacence de Graphe.  Construit par défaut, il délègue à
+ * l'allocateur global; construit avec une arène, il y puise toute sa mémoire.  Deux allocateurs sont égaux s'ils
+ * partagent la même arène.
+ *
+ * @tparam T Type des éléments alloués.
+ */
+template <typename T>
+class AllocateurArcs {
+public:
+    using value_type = T ;
+    using propagate_on_container_copy_assignment = std::true_type ;
+    using propagate_on_container_move_assignment = std::true_type ;
+    using propagate_on_container_swap = std::true_type ;
+
+    AllocateurArcs() noexcept : arena() {}
+
+    explicit AllocateurArcs(std::shared_ptr<ArenaArcs> arena) noexcept : arena(std::move(arena)) {}
+
+    template <typename U>
+    AllocateurArcs(const AllocateurArcs<U>& autre) noexcept : arena(autre.lireArena()) {}
+
+    T* allocate(size_t n) {
+        if (!arena) return static_cast<T*>(::operator new(n * sizeof(T))) ;
+        return static_cast<T*>(arena->allouer(n * sizeof(T))) ;
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (!arena) ::operator delete(p) ;
+        else arena->liberer(p, n * sizeof(T)) ;
+    }
+
+    const std::shared_ptr<ArenaArcs>& lireArena() const noexcept {return arena ; }
+
+private:
+    std::shared_ptr<ArenaArcs> arena ;
+};
+
+template <typename T, typename U>
+bool operator == (const AllocateurArcs<T>& lhs, const AllocateurArcs<U>& rhs) noexcept {
+    return lhs.lireArena() == rhs.lireArena() ;
+}
+
+template <typename T, typename U>
+bool operator != (const AllocateurArcs<T>& lhs, const AllocateurArcs<U>& rhs) noexcept {
+    return !(lhs == rhs) ;
+}
+
+#endif //SIMPLESGRAPHES_ARENAARCS_H
@@ -0,0 +1,369 @@
+//
+// Created by Pascal Charpentier on 2023-07-26.
+//
+
+#include "Biconnexite.h"
+#include "EnsemblesDisjoints.h"
+#include "ParcoursProfondeur.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace {
+
+    /**
+     * @struct ArcNonOriente Une arête vue depuis une de ses extrémités: l'autre extrémité et le numéro de l'arête.
+     */
+    struct ArcNonOriente {
+        size_t destination ;
+        size_t arete ;
+    };
+
+    /**
+     * @class VueNonOrientee
+     *
+     * Vue non orientée d'un graphe, en listes d'adjacence contiguës (CSR): chaque arête figure dans la liste de ses deux
+     * extrémités, avec son numéro.  Offre taille, sommetExiste et enumererVoisins, et se parcourt donc avec
+     * ParcoursProfondeur.
+     */
+    class VueNonOrientee {
+    public:
+        /**
+         * @struct Plage Les arcs d'un sommet, parcourables par une boucle for à intervalle.
+         */
+        struct Plage {
+            const ArcNonOriente* debut ;
+            const ArcNonOriente* fin ;
+
+            const ArcNonOriente* begin()                      const {return debut ; }
+            const ArcNonOriente* end()                        const {return fin ; }
+        };
+
+        /**
+         * Construit la vue.  Le tri et l'élimination des doublons de chaque liste sont confiés à repartir; le reste
+         * est séquentiel et linéaire.
+         * @param graphe Le graphe orienté d'origine
+         * @param repartir Appelable comme ReservoirFils::repartir(nombre, tache)
+         */
+        template <typename S, typename P, typename Repartir>
+        VueNonOrientee(const GrapheGenerique<S, P>& graphe, Repartir& repartir) : aretes(), debuts(), arcs() {
+            const size_t n = graphe.taille() ;
+
+            // Regroupe les arcs par plus petite extrémité, puis trie et dédoublonne chaque groupe.
+            std::vector<size_t> groupes(n + 1, 0) ;
+            for (size_t sommet = 0; sommet < n; ++sommet)
+                for (const auto& arc: graphe.enumererVoisins(sommet))
+                    if (arc.destination != sommet) ++ groupes[std::min<size_t>(sommet, arc.destination) + 1] ;
+            for (size_t sommet = 0; sommet < n; ++sommet) groupes[sommet + 1] += groupes[sommet] ;
+
+            std::vector<size_t> grandes(groupes[n]) ;
+            std::vector<size_t> curseurs(groupes.begin(), groupes.end() - 1) ;
+            for (size_t sommet = 0; sommet < n; ++sommet)
+                for (const auto& arc: graphe.enumererVoisins(sommet))
+                    if (arc.destination != sommet)
+                        grandes[curseurs[std::min<size_t>(sommet, arc.destination)] ++] =
+                            std::max<size_t>(sommet, arc.destination) ;
+
+            std::vector<size_t> distinctes(n + 1, 0) ;
+            repartir(n, [&](size_t debut, size_t fin, size_t) {
+                for (size_t sommet = debut; sommet < fin; ++sommet) {
+                    auto premier = grandes.begin() + static_cast<std::ptrdiff_t>(groupes[sommet]) ;
+                    auto dernier = grandes.begin() + static_cast<std::ptrdiff_t>(groupes[sommet + 1]) ;
+                    std::sort(premier, dernier) ;
+                    distinctes[sommet + 1] = static_cast<size_t>(std::unique(premier, dernier) - premier) ;
+                }
+            }) ;
+            for (size_t sommet = 0; sommet < n; ++sommet) distinctes[sommet + 1] += distinctes[sommet] ;
+
+            aretes.resize(distinctes[n]) ;
+            debuts.assign(n + 1, 0) ;
+            for (size_t sommet = 0; sommet < n; ++sommet)
+                for (size_t i = 0; i < distinctes[sommet + 1] - distinctes[sommet]; ++i) {
+                    aretes[distinctes[sommet] + i] = {sommet, grandes[groupes[sommet] + i]} ;
+                    ++ debuts[sommet + 1] ;
+                    ++ debuts[grandes[groupes[sommet] + i] + 1] ;
+                }
+            for (size_t sommet = 0; sommet < n; ++sommet) debuts[sommet + 1] += debuts[sommet] ;
+
+            arcs.resize(2 * aretes.size()) ;
+            curseurs.assign(debuts.begin(), debuts.end() - 1) ;
+            for (size_t arete = 0; arete < aretes.size(); ++arete) {
+                arcs[curseurs[aretes[arete].first] ++] = {aretes[arete].second, arete} ;
+                arcs[curseurs[aretes[arete].second] ++] = {aretes[arete].first, arete} ;
+            }
+        }
+
+        size_t taille()                                       const {return debuts.size() - 1 ; }
+
+        bool   sommetExiste(size_t sommet)                    const {return sommet < taille() ; }
+
+        Plage  enumererVoisins(size_t sommet)                 const {
+            return Plage {arcs.data() + debuts[sommet], arcs.data() + debuts[sommet + 1]} ;
+        }
+
+        std::vector<std::pair<size_t, size_t>> aretes ;
+
+    private:
+        std::vector<size_t>        debuts ;
+        std::vector<ArcNonOriente> arcs ;
+    };
+
+    /**
+     * Visiteur de Hopcroft-Tarjan.  Les arêtes parcourues sont empilées; lorsqu'un enfant v de p est terminé et que
+     * rien dans son sous-arbre ne remonte au-dessus de p (bas[v] >= rang[p]), les arêtes empilées jusqu'à (p, v)
+     * forment une composante biconnexe.
+     */
+    struct VisiteurHopcroftTarjan : VisiteurProfondeur {
+        std::vector<size_t> rangs ;
+        std::vector<size_t> bas ;
+        std::vector<size_t> aretesParents ;
+        std::vector<size_t> pileAretes ;
+        std::vector<size_t>& etiquettes ;
+        size_t              compteur ;
+        size_t              composantes ;
+
+        VisiteurHopcroftTarjan(size_t nombreSommets, size_t nombreAretes, std::vector<size_t>& etiquettes)
+            : rangs(nombreSommets), bas(nombreSommets), aretesParents(nombreSommets, nombreAretes), pileAretes(),
+              etiquettes(etiquettes), compteur(0), composantes(0) {}
+
+        void decouvrir(size_t sommet) {rangs[sommet] = bas[sommet] = compteur ++ ; }
+
+        void arc(size_t origine, const ArcNonOriente& arc, TypeArc type) {
+            if (type == TypeArc::ARBRE) {
+                aretesParents[arc.destination] = arc.arete ;
+                pileAretes.push_back(arc.arete) ;
+            }
+            // L'arête vers le parent revient comme arc RETOUR; l'autre sens d'une arête de retour arrive comme AVANT.
+            else if (type == TypeArc::RETOUR && arc.arete != aretesParents[origine]) {
+                bas[origine] = std::min(bas[origine], rangs[arc.destination]) ;
+                pileAretes.push_back(arc.arete) ;
+            }
+        }
+
+        void terminer(size_t sommet, size_t parent) {
+            if (parent == rangs.size()) return ;
+            bas[parent] = std::min(bas[parent], bas[sommet]) ;
+            if (bas[sommet] < rangs[parent]) return ;
+
+            size_t arete ;
+            do {
+                arete = pileAretes.back() ;
+                pileAretes.pop_back() ;
+                etiquettes[arete] = composantes ;
+            } while (arete != aretesParents[sommet]) ;
+            ++ composantes ;
+        }
+    };
+
+    /**
+     * Complète le résultat à partir d'étiquettes brutes, qui ne font que distinguer les composantes: renumérotation
+     * dans l'ordre des arêtes, ponts et points d'articulation.
+     */
+    template <typename Repartir>
+    Biconnexite completer(VueNonOrientee& vue, const std::vector<size_t>& brutes, size_t nombreBrutes,
+                          Repartir& repartir) {
+        Biconnexite resultat {std::move(vue.aretes), std::vector<size_t>(brutes.size()), 0, {}, {}} ;
+
+        const size_t aucune = nombreBrutes ;
+        std::vector<size_t> numeros(nombreBrutes, aucune), tailles ;
+        for (size_t arete = 0; arete < brutes.size(); ++arete) {
+            size_t& numero = numeros[brutes[arete]] ;
+            if (numero == aucune) {
+                numero = resultat.nombreComposantes ++ ;
+                tailles.push_back(0) ;
+            }
+            resultat.composantes[arete] = numero ;
+            ++ tailles[numero] ;
+        }
+        for (size_t arete = 0; arete < brutes.size(); ++arete)
+            if (tailles[resultat.composantes[arete]] == 1) resultat.ponts.push_back(arete) ;
+
+        std::vector<char> articulations(vue.taille(), 0) ;
+        repartir(vue.taille(), [&](size_t debut, size_t fin, size_t) {
+            for (size_t sommet = debut; sommet < fin; ++sommet) {
+                auto voisins = vue.enumererVoisins(sommet) ;
+                for (const auto& arc: voisins)
+                    if (resultat.composantes[arc.arete] != resultat.composantes[voisins.begin()->arete]) {
+                        articulations[sommet] = 1 ;
+                        break ;
+                    }
+            }
+        }) ;
+        for (size_t sommet = 0; sommet < vue.taille(); ++sommet)
+            if (articulations[sommet]) resultat.pointsArticulation.push_back(sommet) ;
+        return resultat ;
+    }
+
+}
+
+/**
+ * Calcule les composantes biconnexes, les points d'articulation et les ponts de la vue non orientée d'un graphe, par
+ * l'algorithme de Hopcroft et Tarjan.  Le parcours en profondeur est itératif (ParcoursProfondeur): il tient sur des
+ * graphes de toute profondeur, en O(n + m) après la construction de la vue non orientée.
+ * @param graphe Le graphe à analyser; le sens des arcs est ignoré
+ * @return Les arêtes de la vue non orientée, la composante de chacune, les points d'articulation et les ponts
+ */
+template <typename S, typename P>
+Biconnexite biconnexite(const GrapheGenerique<S, P>& graphe) {
+    auto sequentiel = [](size_t nombre, const ReservoirFils::Tache& tache) {tache(0, nombre, 0) ; } ;
+    VueNonOrientee vue(graphe, sequentiel) ;
+
+    std::vector<size_t> etiquettes(vue.aretes.size()) ;
+    VisiteurHopcroftTarjan visiteur(vue.taille(), vue.aretes.size(), etiquettes) ;
+    parcourirProfondeur(vue, visiteur) ;
+    return completer(vue, etiquettes, visiteur.composantes, sequentiel) ;
+}
+
+/**
+ * Version parallèle de biconnexite, dans l'esprit de l'algorithme de Tarjan et Vishkin, qui remplace le parcours en
+ * profondeur par un arbre couvrant quelconque:
+ *
+ * 1. Les composantes connexes sont calculées par union-find sans verrou; leur plus petit sommet sert de racine.
+ * 2. Un parcours en largeur parallèle, niveau par niveau, construit une forêt couvrante.
+ * 3. Trois passes par niveau calculent la taille des sous-arbres, la numérotation préfixe, puis pour chaque sous-arbre
+ *    bas et haut: le plus petit et le plus grand numéro préfixe atteint par une arête hors de l'arbre.
+ * 4. Les arêtes de l'arbre, désignées par leur sommet enfant, sont réunies par union-find sans verrou: celles des deux
+ *    extrémités d'une arête hors de l'arbre dont aucune n'est l'ancêtre de l'autre, et celles de (p, v) et du parent
+ *    de p lorsque le sous-arbre de v déborde de celui de p.  Chaque arête hors de l'arbre rejoint l'arête de l'arbre
+ *    de son extrémité la plus profonde.
+ *
+ * Les niveaux de moins de 1024 sommets sont traités par le fil appelant.  Le résultat est identique à celui de
+ * biconnexite.
+ * @param graphe Le graphe à analyser; le sens des arcs est ignoré
+ * @param reservoir Réservoir de fils
+ * @return Les arêtes de la vue non orientée, la composante de chacune, les points d'articulation et les ponts
+ */
+template <typename S, typename P>
+Biconnexite biconnexiteParallele(const GrapheGenerique<S, P>& graphe, ReservoirFils& reservoir) {
+    const size_t grain = 1024 ;
+    auto parallele = [&](size_t nombre, const ReservoirFils::Tache& tache) {
+        if (nombre < grain) tache(0, nombre, 0) ;
+        else reservoir.repartir(nombre, tache, grain) ;
+    } ;
+    VueNonOrientee vue(graphe, parallele) ;
+    const size_t n = vue.taille(), m = vue.aretes.size() ;
+
+    EnsemblesDisjointsConcurrents connexes(n) ;
+    parallele(m, [&](size_t debut, size_t fin, size_t) {
+        for (size_t arete = debut; arete < fin; ++arete) connexes.unir(vue.aretes[arete].first, vue.aretes[arete].second) ;
+    }) ;
+
+    // Forêt couvrante en largeur.  Un sommet appartient au premier fil qui le réclame; aretesParents[v] est l'arête
+    // qui relie v à son parent, ou m pour une racine.
+    std::unique_ptr<std::atomic<bool>[]> reclames(new std::atomic<bool>[n]) ;
+    std::vector<size_t> aretesParents(n, m) ;
+    std::vector<std::vector<size_t>> niveaux(1) ;
+    for (size_t sommet = 0; sommet < n; ++sommet) {
+        bool racine = connexes.trouver(sommet) == sommet ;
+        reclames[sommet].store(racine, std::memory_order_relaxed) ;
+        if (racine) niveaux[0].push_back(sommet) ;
+    }
+    std::vector<std::vector<size_t>> suivants(reservoir.taille()) ;
+    while (true) {
+        const std::vector<size_t>& frontiere = niveaux.back() ;
+        parallele(frontiere.size(), [&](size_t debut, size_t fin, size_t fil) {
+            for (size_t i = debut; i < fin; ++i)
+                for (const auto& arc: vue.enumererVoisins(frontiere[i])) {
+                    bool libre = false ;
+                    if (reclames[arc.destination].load(std::memory_order_relaxed)
+                        || !reclames[arc.destination].compare_exchange_strong(libre, true)) continue ;
+                    aretesParents[arc.destination] = arc.arete ;
+                    suivants[fil].push_back(arc.destination) ;
+                }
+        }) ;
+        std::vector<size_t> niveau ;
+        for (auto& locaux: suivants) {
+            niveau.insert(niveau.end(), locaux.begin(), locaux.end()) ;
+            locaux.clear() ;
+        }
+        if (niveau.empty()) break ;
+        niveaux.push_back(std::move(niveau)) ;
+    }
+
+    auto parNiveau = [&](const std::vector<size_t>& niveau, const auto& traiter) {
+        parallele(niveau.size(), [&](size_t debut, size_t fin, size_t) {
+            for (size_t i = debut; i < fin; ++i) traiter(niveau[i]) ;
+        }) ;
+    } ;
+
+    std::vector<size_t> tailles(n) ;
+    for (size_t niveau = niveaux.size(); niveau-- > 0; )
+        parNiveau(niveaux[niveau], [&](size_t sommet) {
+            size_t taille = 1 ;
+            for (const auto& arc: vue.enumererVoisins(sommet))
+                if (aretesParents[arc.destination] == arc.arete) taille += tailles[arc.destination] ;
+            tailles[sommet] = taille ;
+        }) ;
+
+    std::vector<size_t> prefixes(n) ;
+    size_t suivant = 0 ;
+    for (auto racine: niveaux[0]) {
+        prefixes[racine] = suivant ;
+        suivant += tailles[racine] ;
+    }
+    for (const auto& niveau: niveaux)
+        parNiveau(niveau, [&](size_t sommet) {
+            size_t prochain = prefixes[sommet] + 1 ;
+            for (const auto& arc: vue.enumererVoisins(sommet))
+                if (aretesParents[arc.destination] == arc.arete) {
+                    prefixes[arc.destination] = prochain ;
+                    prochain += tailles[arc.destination] ;
+                }
+        }) ;
+
+    std::vector<size_t> bas(n), hauts(n) ;
+    for (size_t niveau = niveaux.size(); niveau-- > 0; )
+        parNiveau(niveaux[niveau], [&](size_t sommet) {
+            size_t minimum = prefixes[sommet], maximum = prefixes[sommet] ;
+            for (const auto& arc: vue.enumererVoisins(sommet)) {
+                if (aretesParents[arc.destination] == arc.arete) {
+                    minimum = std::min(minimum, bas[arc.destination]) ;
+                    maximum = std::max(maximum, hauts[arc.destination]) ;
+                }
+                else if (arc.arete != aretesParents[sommet]) {
+                    minimum = std::min(minimum, prefixes[arc.destination]) ;
+                    maximum = std::max(maximum, prefixes[arc.destination]) ;
+                }
+            }
+            bas[sommet] = minimum ;
+            hauts[sommet] = maximum ;
+        }) ;
+
+    EnsemblesDisjointsConcurrents blocs(n) ;
+    parallele(n, [&](size_t debut, size_t fin, size_t) {
+        for (size_t sommet = debut; sommet < fin; ++sommet) {
+            const size_t premier = prefixes[sommet], apres = prefixes[sommet] + tailles[sommet] ;
+            for (const auto& arc: vue.enumererVoisins(sommet)) {
+                const size_t voisin = arc.destination ;
+                if (aretesParents[voisin] == arc.arete) {
+                    if (aretesParents[sommet] != m && (bas[voisin] < premier || hauts[voisin] >= apres))
+                        blocs.unir(voisin, sommet) ;
+                }
+                else if (arc.arete != aretesParents[sommet] && premier < prefixes[voisin] && prefixes[voisin] >= apres)
+                    blocs.unir(sommet, voisin) ;
+            }
+        }
+    }) ;
+
+    std::vector<size_t> etiquettes(m) ;
+    parallele(m, [&](size_t debut, size_t fin, size_t) {
+        for (size_t arete = debut; arete < fin; ++arete) {
+            size_t u = vue.aretes[arete].first, v = vue.aretes[arete].second ;
+            size_t enfant = aretesParents[u] == arete ? u
+                          : aretesParents[v] == arete ? v
+                          : prefixes[u] > prefixes[v] ? u : v ;
+            etiquettes[arete] = blocs.trouver(enfant) ;
+        }
+    }) ;
+    return completer(vue, etiquettes, n, parallele) ;
+}
+
+#define SIMPLESGRAPHES_INSTANCIER_BICONNEXITE(S, P) \
+    template Biconnexite biconnexite(const GrapheGenerique<S, P>&) ; \
+    template Biconnexite biconnexiteParallele(const GrapheGenerique<S, P>&, ReservoirFils&) ;
+
+SIMPLESGRAPHES_INSTANCIER_BICONNEXITE(size_t, double)
+SIMPLESGRAPHES_INSTANCIER_BICONNEXITE(uint32_t, float)
+SIMPLESGRAPHES_INSTANCIER_BICONNEXITE(uint32_t, uint32_t)
+SIMPLESGRAPHES_INSTANCIER_BICONNEXITE(uint32_t, SansPoids)
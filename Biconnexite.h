@@ -0,0 +1,41 @@
+//
+// Created by Pascal Charpentier on 2023-07-26.
+//
+
+#ifndef SIMPLESGRAPHES_BICONNEXITE_H
+#define SIMPLESGRAPHES_BICONNEXITE_H
+
+#include "Graphe.h"
+#include "ReservoirFils.h"
+
+#include <utility>
+#include <vector>
+
+/**
+ * @struct Biconnexite Composantes biconnexes de la vue non orientée d'un graphe.
+ *
+ * aretes: les arêtes de la vue non orientée, chacune sous la forme (u, v) avec u < v, en ordre lexicographique.  Les
+ * arcs u -> v et v -> u ne forment qu'une arête; les boucles sont ignorées.
+ * composantes: pour chaque arête, le numéro de sa composante biconnexe.  Les composantes sont numérotées de 0 à
+ * nombreComposantes - 1 dans l'ordre de leur première arête, de sorte que le résultat ne dépend pas de l'algorithme.
+ * pointsArticulation: les sommets dont le retrait déconnecte leur composante connexe, en ordre croissant.  Ce sont
+ * ceux qui touchent plusieurs composantes biconnexes.
+ * ponts: les indices (dans aretes) des arêtes dont le retrait déconnecte leur composante connexe, en ordre croissant.
+ * Ce sont les composantes biconnexes d'une seule arête.
+ */
+struct Biconnexite {
+    std::vector<std::pair<size_t, size_t>> aretes ;
+    std::vector<size_t> composantes ;
+    size_t nombreComposantes ;
+    std::vector<size_t> pointsArticulation ;
+    std::vector<size_t> ponts ;
+};
+
+template <typename S, typename P>
+Biconnexite biconnexite(const GrapheGenerique<S, P>& graphe) ;
+
+template <typename S, typename P>
+Biconnexite biconnexiteParallele(const GrapheGenerique<S, P>& graphe,
+                                 ReservoirFils& reservoir = ReservoirFils::parDefaut()) ;
+
+#endif //SIMPLESGRAPHES_BICONNEXITE_H
@@ -0,0 +1,180 @@
+//
+// Created by Pascal Charpentier on 2023-07-21.
+//
+
+#include "CacheDijkstra.h"
+
+#include <stdexcept>
+
+/**
+ * Construit un cache vide.
+ * @param graphe Le graphe interrogé, qui doit survivre au cache
+ * @param budgetOctets Mémoire maximale occupée par les résultats conservés
+ * @param politique Politique d'éviction
+ */
+template <typename S, typename P>
+CacheDijkstra<S, P>::CacheDijkstra(const GrapheGenerique<S, P>& graphe, size_t budgetOctets, PolitiqueEviction politique)
+    : graphe(graphe), budget(budgetOctets), politique(politique), verrou(), version(graphe.version()), horloge(0),
+      entrees(), ordre(), octets(0), nombreSucces(0), nombreEchecs(0), nombreEvictions(0) {}
+
+/**
+ * Donne les plus courts chemins à partir d'une source, calculés au besoin.  Le calcul se fait hors du verrou: deux
+ * fils qui demandent en même temps une même source absente la calculent tous deux, et le second résultat remplace
+ * le premier.  Un résultat plus gros que le budget est retourné sans être conservé.
+ * @param source Numéro du sommet source
+ * @return Les résultats de dijkstraFilePrioritaire pour cette source, sur la version courante du graphe
+ * @except std::invalid_argument si la source n'est pas dans le graphe
+ */
+template <typename S, typename P>
+std::shared_ptr<const typename CacheDijkstra<S, P>::Resultats> CacheDijkstra<S, P>::obtenir(size_t source) {
+    if (!graphe.sommetExiste(source)) throw std::invalid_argument("CacheDijkstra::obtenir: source invalide") ;
+
+    {
+        std::lock_guard<std::mutex> garde(verrou) ;
+        verifierVersion() ;
+        auto trouve = entrees.find(source) ;
+        if (trouve != entrees.end()) {
+            Entree& entree = trouve->second ;
+            ordre.erase(cle(source, entree)) ;
+            ++ entree.frequence ;
+            entree.dernierUsage = ++ horloge ;
+            ordre.insert(cle(source, entree)) ;
+            ++ nombreSucces ;
+            return entree.resultats ;
+        }
+        ++ nombreEchecs ;
+    }
+
+    auto resultats = std::make_shared<const Resultats>(dijkstraFilePrioritaire(graphe, source)) ;
+    const size_t taille = sizeof(Resultats) + resultats->distances.capacity() * sizeof(P)
+                          + resultats->predecesseurs.capacity() * sizeof(size_t) ;
+
+    std::lock_guard<std::mutex> garde(verrou) ;
+    verifierVersion() ;
+    if (taille > budget) return resultats ;
+
+    auto trouve = entrees.find(source) ;
+    if (trouve != entrees.end()) {
+        ordre.erase(cle(source, trouve->second)) ;
+        octets -= trouve->second.octets ;
+        entrees.erase(trouve) ;
+    }
+    evincer(taille) ;
+
+    Entree entree {resultats, taille, 1, ++ horloge} ;
+    ordre.insert(cle(source, entree)) ;
+    entrees.emplace(source, std::move(entree)) ;
+    octets += taille ;
+    return resultats ;
+}
+
+/**
+ * Reconstruit un plus court chemin à partir de l'arbre mis en cache pour la source, en O(longueur du chemin) lorsque
+ * la source y est déjà.
+ * @param source Numéro du sommet source
+ * @param destination Numéro du sommet d'arrivée
+ * @param chemin Reçoit les sommets du chemin; vide si la destination est inaccessible.  Sa capacité est réutilisée.
+ * @return La longueur du chemin, ou TraitsPoids<P>::infini() si la destination est inaccessible
+ * @except std::invalid_argument si un des sommets n'est pas dans le graphe
+ */
+template <typename S, typename P>
+P CacheDijkstra<S, P>::chemin(size_t source, size_t destination, std::vector<size_t>& chemin) {
+    return extraireChemin(*obtenir(source), destination, chemin) ;
+}
+
+/**
+ * Retire toutes les entrées.  Les compteurs de succès, d'échecs et d'évictions sont conservés.
+ */
+template <typename S, typename P>
+void CacheDijkstra<S, P>::vider() {
+    std::lock_guard<std::mutex> garde(verrou) ;
+    entrees.clear() ;
+    ordre.clear() ;
+    octets = 0 ;
+}
+
+/**
+ * @return Le nombre de sources conservées
+ */
+template <typename S, typename P>
+size_t CacheDijkstra<S, P>::nombreEntrees() const {
+    std::lock_guard<std::mutex> garde(verrou) ;
+    return entrees.size() ;
+}
+
+/**
+ * @return La mémoire occupée par les résultats conservés, en octets
+ */
+template <typename S, typename P>
+size_t CacheDijkstra<S, P>::octetsUtilises() const {
+    std::lock_guard<std::mutex> garde(verrou) ;
+    return octets ;
+}
+
+/**
+ * @return Le nombre de requêtes servies à partir du cache
+ */
+template <typename S, typename P>
+uint64_t CacheDijkstra<S, P>::succes() const {
+    std::lock_guard<std::mutex> garde(verrou) ;
+    return nombreSucces ;
+}
+
+/**
+ * @return Le nombre de requêtes qui ont exigé un calcul
+ */
+template <typename S, typename P>
+uint64_t CacheDijkstra<S, P>::echecs() const {
+    std::lock_guard<std::mutex> garde(verrou) ;
+    return nombreEchecs ;
+}
+
+/**
+ * @return Le nombre d'entrées évincées pour respecter le budget
+ */
+template <typename S, typename P>
+uint64_t CacheDijkstra<S, P>::evictions() const {
+    std::lock_guard<std::mutex> garde(verrou) ;
+    return nombreEvictions ;
+}
+
+/**
+ * Clé d'ordre d'éviction d'une entrée: la plus petite est évincée en premier.
+ */
+template <typename S, typename P>
+typename CacheDijkstra<S, P>::CleEviction CacheDijkstra<S, P>::cle(size_t source, const Entree& entree) const {
+    if (politique == PolitiqueEviction::LFU) return CleEviction(entree.frequence, entree.dernierUsage, source) ;
+    return CleEviction(entree.dernierUsage, 0, source) ;
+}
+
+/**
+ * Vide le cache si le graphe a changé depuis le calcul des entrées.  Appelée sous le verrou.
+ */
+template <typename S, typename P>
+void CacheDijkstra<S, P>::verifierVersion() {
+    if (graphe.version() == version) return ;
+    entrees.clear() ;
+    ordre.clear() ;
+    octets = 0 ;
+    version = graphe.version() ;
+}
+
+/**
+ * Évince des entrées jusqu'à ce qu'une nouvelle entrée de la taille donnée tienne dans le budget.  Appelée sous le
+ * verrou.
+ */
+template <typename S, typename P>
+void CacheDijkstra<S, P>::evincer(size_t octetsRequis) {
+    while (!ordre.empty() && octets + octetsRequis > budget) {
+        size_t source = std::get<2>(*ordre.begin()) ;
+        ordre.erase(ordre.begin()) ;
+        auto trouve = entrees.find(source) ;
+        octets -= trouve->second.octets ;
+        entrees.erase(trouve) ;
+        ++ nombreEvictions ;
+    }
+}
+
+template class CacheDijkstra<size_t, double> ;
+template class CacheDijkstra<uint32_t, float> ;
+template class CacheDijkstra<uint32_t, uint32_t> ;
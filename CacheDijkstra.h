@@ -0,0 +1,93 @@
+//
+// Created by Pascal Charpentier on 2023-07-21.
+//
+
+#ifndef SIMPLESGRAPHES_CACHEDIJKSTRA_H
+#define SIMPLESGRAPHES_CACHEDIJKSTRA_H
+
+#include "Graphe.h"
+#include "Graphe_algorithmes.h"
+
+#include <memory>
+#include <mutex>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Politique d'éviction d'un CacheDijkstra: la source utilisée le moins récemment (LRU), ou la moins souvent, la moins
+ * récente départageant les égalités (LFU).
+ */
+enum class PolitiqueEviction {LRU, LFU} ;
+
+/**
+ * @class CacheDijkstra
+ *
+ * Cache borné des résultats de dijkstraFilePrioritaire, par sommet source, pour les charges où quelques sources
+ * reviennent sans cesse.  La mémoire occupée par les résultats conservés ne dépasse jamais le budget: les entrées sont
+ * évincées selon la politique choisie.  Chaque entrée est associée à la version du graphe (voir
+ * GrapheGenerique::version); dès que le graphe est modifié, tout le cache est invalidé à la requête suivante.
+ *
+ * Les résultats sont remis en shared_ptr: une éviction ne détruit jamais un résultat encore utilisé par un appelant.
+ * Le cache peut être interrogé par plusieurs fils à la fois, mais le graphe ne doit pas être modifié pendant ce temps.
+ *
+ * @tparam S Type des sommets du graphe
+ * @tparam P Type de la pondération
+ */
+template <typename S, typename P>
+class CacheDijkstra {
+public:
+    using Resultats = ResultatsDijkstraGenerique<P> ;
+
+    CacheDijkstra(const GrapheGenerique<S, P>& graphe, size_t budgetOctets,
+                  PolitiqueEviction politique = PolitiqueEviction::LRU) ;
+
+    std::shared_ptr<const Resultats> obtenir(size_t source) ;
+
+    P                                chemin(size_t source, size_t destination, std::vector<size_t>& chemin) ;
+
+    void                             vider() ;
+
+    size_t                           nombreEntrees()                        const ;
+
+    size_t                           octetsUtilises()                       const ;
+
+    uint64_t                         succes()                               const ;
+
+    uint64_t                         echecs()                               const ;
+
+    uint64_t                         evictions()                            const ;
+
+private:
+    using CleEviction = std::tuple<uint64_t, uint64_t, size_t> ;
+
+    struct Entree {
+        std::shared_ptr<const Resultats> resultats ;
+        size_t octets ;
+        uint64_t frequence ;
+        uint64_t dernierUsage ;
+    };
+
+    CleEviction                      cle(size_t source, const Entree& entree) const ;
+
+    void                             verifierVersion() ;
+
+    void                             evincer(size_t octetsRequis) ;
+
+    const GrapheGenerique<S, P>&              graphe ;
+    size_t                                    budget ;
+    PolitiqueEviction                         politique ;
+
+    mutable std::mutex                        verrou ;
+    uint64_t                                  version ;
+    uint64_t                                  horloge ;
+    std::unordered_map<size_t, Entree>        entrees ;
+    std::set<CleEviction>                     ordre ;
+    size_t                                    octets ;
+    uint64_t                                  nombreSucces ;
+    uint64_t                                  nombreEchecs ;
+    uint64_t                                  nombreEvictions ;
+};
+
+#endif //SIMPLESGRAPHES_CACHEDIJKSTRA_H
@@ -0,0 +1,85 @@
+//
+// Created by Pascal Charpentier on 2023-07-10.
+//
+
+#include "ComposantesIncrementales.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+/**
+ * Construit les composantes d'un graphe de n sommets sans arc: chaque sommet est sa propre composante.
+ * @param nombre Nombre de sommets
+ */
+ComposantesIncrementales::ComposantesIncrementales(size_t nombre) : ensembles(nombre), minimums(nombre) {
+    std::iota(minimums.begin(), minimums.end(), 0) ;
+}
+
+/**
+ * À appeler lorsqu'un sommet est ajouté au graphe.  Le nouveau sommet forme sa propre composante.
+ */
+void ComposantesIncrementales::ajouterSommet() {
+    minimums.push_back(ensembles.ajouter()) ;
+}
+
+/**
+ * À appeler lorsqu'un arc est ajouté au graphe.  Le sens de l'arc n'a pas d'importance.
+ * @param depart Numéro du sommet de départ
+ * @param arrivee Numéro du sommet d'arrivée
+ * @except std::invalid_argument si un des sommets n'existe pas
+ */
+void ComposantesIncrementales::ajouterArc(size_t depart, size_t arrivee) {
+    if (depart >= taille() || arrivee >= taille()) throw std::invalid_argument("ajouterArc: sommet inexistant") ;
+
+    size_t a = ensembles.trouver(depart) ;
+    size_t b = ensembles.trouver(arrivee) ;
+    if (a == b) return ;
+
+    size_t minimum = std::min(minimums[a], minimums[b]) ;
+    ensembles.unir(a, b) ;
+    minimums[ensembles.trouver(a)] = minimum ;
+}
+
+/**
+ * @return Le nombre de sommets suivis
+ */
+size_t ComposantesIncrementales::taille() const {
+    return minimums.size() ;
+}
+
+/**
+ * @return Le nombre de composantes faiblement connexes
+ */
+size_t ComposantesIncrementales::nombreComposantes() const {
+    return ensembles.nombreEnsembles() ;
+}
+
+/**
+ * Vérifie si deux sommets appartiennent à la même composante.
+ * @param a Premier sommet
+ * @param b Second sommet
+ * @return true s'ils sont reliés par une chaîne d'arcs, sans égard à leur sens
+ */
+bool ComposantesIncrementales::memeComposante(size_t a, size_t b) {
+    return ensembles.trouver(a) == ensembles.trouver(b) ;
+}
+
+/**
+ * Donne l'identifiant de la composante d'un sommet, soit le plus petit numéro de sommet de cette composante.  C'est la
+ * même convention que composantesFaiblementConnexes.
+ * @param sommet Numéro du sommet
+ * @return L'identifiant de sa composante
+ */
+size_t ComposantesIncrementales::composante(size_t sommet) {
+    return minimums[ensembles.trouver(sommet)] ;
+}
+
+/**
+ * @return L'identifiant de composante de chaque sommet
+ */
+std::vector<size_t> ComposantesIncrementales::etiquettes() {
+    std::vector<size_t> resultat(taille()) ;
+    for (size_t sommet = 0; sommet < taille(); ++sommet) resultat[sommet] = composante(sommet) ;
+    return resultat ;
+}
@@ -0,0 +1,57 @@
+//
+// Created by Pascal Charpentier on 2023-07-10.
+//
+
+#ifndef SIMPLESGRAPHES_COMPOSANTESINCREMENTALES_H
+#define SIMPLESGRAPHES_COMPOSANTESINCREMENTALES_H
+
+#include "Graphe.h"
+#include "EnsemblesDisjoints.h"
+
+#include <vector>
+
+/**
+ * @class ComposantesIncrementales
+ *
+ * Tient à jour les composantes faiblement connexes d'un graphe en croissance.  On lui transmet les mêmes appels
+ * ajouterSommet et ajouterArc qu'au graphe, au fil de l'eau, et les composantes sont disponibles en tout temps, sans
+ * recalcul.  Le retrait de sommets ou d'arcs n'est pas supporté: il faut alors reconstruire l'objet.
+ */
+class ComposantesIncrementales {
+public:
+    explicit ComposantesIncrementales(size_t nombre = 0) ;
+
+    template <typename S, typename P>
+    explicit ComposantesIncrementales(const GrapheGenerique<S, P>& graphe) ;
+
+    void                ajouterSommet() ;
+
+    void                ajouterArc(size_t depart, size_t arrivee) ;
+
+    size_t              taille()                                      const ;
+
+    size_t              nombreComposantes()                           const ;
+
+    bool                memeComposante(size_t a, size_t b) ;
+
+    size_t              composante(size_t sommet) ;
+
+    std::vector<size_t> etiquettes() ;
+
+private:
+    EnsemblesDisjoints ensembles ;
+    std::vector<size_t> minimums ;
+};
+
+/**
+ * Construit les composantes d'un graphe existant.  Les arcs ajoutés ensuite au graphe doivent aussi être transmis à
+ * l'objet.
+ * @param graphe Le graphe de départ
+ */
+template <typename S, typename P>
+ComposantesIncrementales::ComposantesIncrementales(const GrapheGenerique<S, P>& graphe) : ComposantesIncrementales(graphe.taille()) {
+    for (size_t depart = 0; depart < graphe.taille(); ++depart)
+        for (const auto& arc: graphe.enumererVoisins(depart)) ajouterArc(depart, arc.destination) ;
+}
+
+#endif //SIMPLESGRAPHES_COMPOSANTESINCREMENTALES_H
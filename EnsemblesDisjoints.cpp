@@ -0,0 +1,132 @@
+//
+// Created by Pascal Charpentier on 2023-06-28.
+//
+
+#include "EnsemblesDisjoints.h"
+
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * Construit une partition où chaque élément est seul dans son ensemble.
+ * @param nombre Nombre d'éléments
+ */
+EnsemblesDisjoints::EnsemblesDisjoints(size_t nombre) : parents(nombre), rangs(nombre, 0), ensembles(nombre) {
+    std::iota(parents.begin(), parents.end(), 0) ;
+}
+
+/**
+ * Ajoute un nouvel élément, seul dans son ensemble.
+ * @return Le numéro du nouvel élément
+ */
+size_t EnsemblesDisjoints::ajouter() {
+    parents.push_back(parents.size()) ;
+    rangs.push_back(0) ;
+    ++ ensembles ;
+    return parents.size() - 1 ;
+}
+
+/**
+ * Trouve le représentant de l'ensemble contenant un élément.  Le chemin parcouru est compressé: chaque élément visité
+ * pointe ensuite directement vers le représentant.
+ * @param element Entier entre 0 et taille() - 1
+ * @return Le représentant de l'ensemble
+ * @except std::out_of_range si l'élément n'existe pas
+ */
+size_t EnsemblesDisjoints::trouver(size_t element) {
+    size_t racine = parents.at(element) ;
+    while (racine != parents[racine]) racine = parents[racine] ;
+
+    while (parents[element] != racine) {
+        size_t suivant = parents[element] ;
+        parents[element] = racine ;
+        element = suivant ;
+    }
+    return racine ;
+}
+
+/**
+ * Réunit les ensembles de deux éléments.
+ * @param a Premier élément
+ * @param b Second élément
+ * @return true si les deux éléments étaient dans des ensembles différents
+ */
+bool EnsemblesDisjoints::unir(size_t a, size_t b) {
+    a = trouver(a) ;
+    b = trouver(b) ;
+    if (a == b) return false ;
+
+    if (rangs[a] < rangs[b]) std::swap(a, b) ;
+    parents[b] = a ;
+    if (rangs[a] == rangs[b]) ++ rangs[a] ;
+    -- ensembles ;
+    return true ;
+}
+
+/**
+ * @return Le nombre d'éléments de la partition
+ */
+size_t EnsemblesDisjoints::taille() const {
+    return parents.size() ;
+}
+
+/**
+ * @return Le nombre d'ensembles distincts
+ */
+size_t EnsemblesDisjoints::nombreEnsembles() const {
+    return ensembles ;
+}
+
+/**
+ * Construit une partition où chaque élément est seul dans son ensemble.
+ * @param nombre Nombre d'éléments
+ */
+EnsemblesDisjointsConcurrents::EnsemblesDisjointsConcurrents(size_t nombre) : nombre(nombre),
+                                                                              parents(new std::atomic<size_t>[nombre]) {
+    for (size_t i = 0; i < nombre; ++i) parents[i].store(i, std::memory_order_relaxed) ;
+}
+
+/**
+ * Trouve le représentant de l'ensemble contenant un élément, en faisant pointer au passage chaque élément visité vers
+ * son grand-parent.  Peut être appelée en même temps que d'autres recherches ou unions.
+ * @param element Entier entre 0 et taille() - 1
+ * @return Le représentant, soit le plus petit élément de l'ensemble au moment de l'appel
+ * @except std::out_of_range si l'élément n'existe pas
+ */
+size_t EnsemblesDisjointsConcurrents::trouver(size_t element) {
+    if (element >= nombre) throw std::out_of_range("EnsemblesDisjointsConcurrents::trouver: élément inexistant") ;
+
+    while (true) {
+        size_t parent = parents[element].load() ;
+        if (parent == element) return element ;
+        size_t grandParent = parents[parent].load() ;
+        if (parent != grandParent) parents[element].compare_exchange_weak(parent, grandParent) ;
+        element = grandParent ;
+    }
+}
+
+/**
+ * Réunit les ensembles de deux éléments.  Peut être appelée en même temps que d'autres recherches ou unions.
+ * @param a Premier élément
+ * @param b Second élément
+ * @return true si cet appel a fusionné deux ensembles distincts
+ */
+bool EnsemblesDisjointsConcurrents::unir(size_t a, size_t b) {
+    while (true) {
+        a = trouver(a) ;
+        b = trouver(b) ;
+        if (a == b) return false ;
+        if (a < b) std::swap(a, b) ;
+
+        size_t attendu = a ;
+        if (parents[a].compare_exchange_strong(attendu, b)) return true ;
+    }
+}
+
+/**
+ * @return Le nombre d'éléments de la partition
+ */
+size_t EnsemblesDisjointsConcurrents::taille() const {
+    return nombre ;
+}
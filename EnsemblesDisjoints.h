@@ -0,0 +1,62 @@
+//
+// Created by Pascal Charpentier on 2023-06-28.
+//
+
+#ifndef SIMPLESGRAPHES_ENSEMBLESDISJOINTS_H
+#define SIMPLESGRAPHES_ENSEMBLESDISJOINTS_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @class EnsemblesDisjoints
+ *
+ * Structure union-find classique sur les entiers 0 à n - 1.  Au départ, chaque élément forme son propre ensemble.  La
+ * compression des chemins et l'union par rang garantissent un coût amorti quasi constant par opération.
+ */
+class EnsemblesDisjoints {
+public:
+    explicit EnsemblesDisjoints(size_t nombre) ;
+
+    size_t ajouter() ;
+
+    size_t trouver(size_t element) ;
+
+    bool   unir(size_t a, size_t b) ;
+
+    size_t taille()                              const ;
+
+    size_t nombreEnsembles()                     const ;
+
+private:
+    std::vector<size_t>        parents ;
+    std::vector<unsigned char> rangs ;
+    size_t                     ensembles ;
+};
+
+/**
+ * @class EnsemblesDisjointsConcurrents
+ *
+ * Variante sans verrou d'EnsemblesDisjoints, utilisable simultanément par plusieurs fils.  Les parents sont des entiers
+ * atomiques qui ne font que décroître: une union rattache toujours la plus grande des deux racines à la plus petite,
+ * par compare-and-swap, et la recherche raccourcit les chemins par division (path halving).  Le représentant d'un
+ * ensemble est donc toujours son plus petit élément.
+ */
+class EnsemblesDisjointsConcurrents {
+public:
+    explicit EnsemblesDisjointsConcurrents(size_t nombre) ;
+
+    size_t trouver(size_t element) ;
+
+    bool   unir(size_t a, size_t b) ;
+
+    size_t taille()                              const ;
+
+private:
+    size_t                                 nombre ;
+    std::unique_ptr<std::atomic<size_t>[]> parents ;
+};
+
+#endif //SIMPLESGRAPHES_ENSEMBLESDISJOINTS_H
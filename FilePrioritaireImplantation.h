@@ -14,6 +14,8 @@
  */
 template<typename T>
 FilePrioritaire<T>::FilePrioritaire(const std::vector<T>& donnees) : heapSize(donnees.size()), heap(), index() {
+    heap.reserve(donnees.size()) ;
+    index.reserve(donnees.size()) ;
     for (size_t i = 0; i < donnees.size(); ++i) {
         index.emplace_back(donnees.at(i), i) ;
         heap.emplace_back(donnees.at(i), i) ;
@@ -138,6 +140,7 @@ size_t FilePrioritaire<T>::lireIndexMinimum() const {
 template<typename T>
 std::vector<T> FilePrioritaire<T>::genererIndex() const {
     std::vector<T> resultat ;
+    resultat.reserve(index.size()) ;
     for (size_t i = 0; i < index.size(); ++i) resultat.push_back(index.at(i).data) ;
     return resultat ;
 }
@@ -4,19 +4,54 @@
 
 #include "Graphe.h"
 
+#include <atomic>
+
+namespace {
+
+    /**
+     * Donne un numéro de version jamais attribué auparavant, à aucun graphe: deux états distincts de graphes, même de
+     * graphes différents, n'ont donc jamais la même version.
+     */
+    uint64_t nouvelleVersion() {
+        static std::atomic<uint64_t> compteur {0} ;
+        return ++ compteur ;
+    }
+
+}
 
 /**
  * Construit un graphe comportant un nombre donné de sommets.  Par défaut, un graphe vide sera construit.
  * @param nombre Nombre entier positif ou nul.  Le nombre de sommets voulus.
  */
-Graphe::Graphe(size_t nombre) : listes(nombre) {
+template <typename S, typename P>
+GrapheGenerique<S, P>::GrapheGenerique(size_t nombre) : allocateur(), listes(), revision(nouvelleVersion()) {
+    verifierCapacite(nombre) ;
+    listes.resize(nombre) ;
+}
+
+/**
+ * Construit un graphe dont les arcs seront alloués dans une arène.  La construction et la destruction d'un grand graphe
+ * ne coûtent alors que quelques grosses allocations.  L'arène peut être partagée entre plusieurs graphes; elle est
+ * libérée lorsque le dernier graphe qui l'utilise est détruit.
+ * @param nombre Nombre entier positif ou nul.  Le nombre de sommets voulus.
+ * @param arena L'arène où seront alloués les arcs.  Si nulle, les arcs sont alloués dans le tas comme d'habitude.
+ */
+template <typename S, typename P>
+GrapheGenerique<S, P>::GrapheGenerique(size_t nombre, std::shared_ptr<ArenaArcs> arena) : allocateur(std::move(arena)),
+                                                                                     listes(),
+                                                                                     revision(nouvelleVersion()) {
+    verifierCapacite(nombre) ;
+    listes.resize(nombre, ListeArcs(allocateur)) ;
 }
 
 /**
  * Ajouter un sommet au graphe.  Si le graphe a n sommets, il en aura ensuite n+1.
  */
-void Graphe::ajouterSommet() {
-    listes.emplace_back() ;
+template <typename S, typename P>
+void GrapheGenerique<S, P>::ajouterSommet() {
+    verifierCapacite(listes.size() + 1) ;
+    listes.emplace_back(allocateur) ;
+    revision = nouvelleVersion() ;
 }
 
 /**
@@ -27,12 +62,13 @@ void Graphe::ajouterSommet() {
  * @return true si une arête existe entre les deux sommets.
  * @except invalid_argument si un des deux arguments n'est pas un sommet présent dans le graphe.
  */
-bool Graphe::arcExiste(size_t depart, size_t arrivee) const {
+template <typename S, typename P>
+bool GrapheGenerique<S, P>::arcExiste(size_t depart, size_t arrivee) const {
     if (!sommetExiste(depart)) throw std::invalid_argument("arcExiste: depart invalide") ;
     if (!sommetExiste(arrivee)) throw std::invalid_argument("arcExiste: arrivée invalide") ;
 
-    auto liste = listes.at(depart) ;
-    return std::any_of(liste.begin(), liste.end(), [&arrivee](Arc e) {return e.destination == arrivee ; }) ;
+    const auto& liste = listes.at(depart) ;
+    return std::any_of(liste.begin(), liste.end(), [&arrivee](const Arc& e) {return e.destination == arrivee ; }) ;
 }
 
 /**
@@ -40,7 +76,8 @@ bool Graphe::arcExiste(size_t depart, size_t arrivee) const {
  * @param numero Nombre entier positif désignant un éventuel sommet.
  * @return true si le paramètre numero désigne bien un sommet présent dans le graphe.
  */
-bool Graphe::sommetExiste(size_t numero) const {
+template <typename S, typename P>
+bool GrapheGenerique<S, P>::sommetExiste(size_t numero) const {
     return numero < listes.size() ;
 }
 
@@ -48,23 +85,44 @@ bool Graphe::sommetExiste(size_t numero) const {
  * Ajoute une arête d'un poids donné, entre un sommet de départ et un sommet d'arrivée.
  * @param depart Entier positif désignant le sommet de départ
  * @param arrivee Entier positif désignant le sommet d'arrivée
- * @param poids Un double représentant la pondération de l'arête.
+ * @param poids La pondération de l'arête.  Par défaut, le poids unitaire du type de pondération.
  * @except invalid_argument si un des numéros de sommet ne représente pas un des sommets du graphe.
  * @except invalid_argument si on veut ajouter un arc déjà présent entre deux sommets.
  */
-void Graphe::ajouterArc(size_t depart, size_t arrivee, double poids) {
+template <typename S, typename P>
+void GrapheGenerique<S, P>::ajouterArc(size_t depart, size_t arrivee, P poids) {
     if (arcExiste(depart, arrivee)) throw std::invalid_argument("ajouterArc: l'arc existe déjà.") ;
 
     listes.at(depart).emplace_back(arrivee, poids) ;
+    revision = nouvelleVersion() ;
+}
+
+/**
+ * Ajoute un arc que l'appelant sait absent, sans parcourir la liste du départ: en temps constant plutôt qu'en
+ * O(arité).  Sert à construire un graphe à partir d'un autre, dont les arcs sont déjà distincts.
+ * @param depart Entier positif désignant le sommet de départ
+ * @param arrivee Entier positif désignant le sommet d'arrivée
+ * @param poids La pondération de l'arête.  Par défaut, le poids unitaire du type de pondération.
+ * @pre L'arc n'existe pas déjà; sinon le graphe contiendra deux arcs entre les mêmes sommets
+ * @except invalid_argument si un des numéros de sommet ne représente pas un des sommets du graphe.
+ */
+template <typename S, typename P>
+void GrapheGenerique<S, P>::ajouterArcDistinct(size_t depart, size_t arrivee, P poids) {
+    if (!sommetExiste(depart)) throw std::invalid_argument("ajouterArcDistinct: depart invalide") ;
+    if (!sommetExiste(arrivee)) throw std::invalid_argument("ajouterArcDistinct: arrivée invalide") ;
+
+    listes[depart].emplace_back(arrivee, poids) ;
+    revision = nouvelleVersion() ;
 }
 
 /**
  * Énumère les arêtes partant d'un sommet de départ.  Chaque arête comportant un sommet de destination et une pondération.
  * @param depart Numéro du sommet de départ.
- * @return Un std::list dont chaque élément est un struct Arc comportant un champ destination et un champ pondération.
+ * @return Une liste dont chaque élément est un struct Arc comportant un champ destination et un champ pondération.
  * @except invalid_argument si le paramètre départ ne représente pas un sommet du graphe.
  */
-const std::list<Graphe::Arc>& Graphe::enumererVoisins(size_t depart) const {
+template <typename S, typename P>
+const typename GrapheGenerique<S, P>::ListeArcs& GrapheGenerique<S, P>::enumererVoisins(size_t depart) const {
     if (!sommetExiste(depart)) throw std::invalid_argument("enumererVoisins: sommet inexistant") ;
     return listes.at(depart) ;
 }
@@ -74,7 +132,8 @@ const std::list<Graphe::Arc>& Graphe::enumererVoisins(size_t depart) const {
  * @param sommet Entier positif dénotant le sommet dont on veut connaître l'arité d'entrée.
  * @return Un entier positif représentant l'arité d'entrée du sommet.
  */
-size_t Graphe::ariteEntree(size_t sommet) const {
+template <typename S, typename P>
+size_t GrapheGenerique<S, P>::ariteEntree(size_t sommet) const {
     if (!sommetExiste(sommet)) throw std::invalid_argument("ariteEntree: sommet invalide.") ;
     auto arite = 0 ;
 
@@ -89,13 +148,13 @@ size_t Graphe::ariteEntree(size_t sommet) const {
  * arêtes a été inversé.
  * @return Un objet graphe représentant l'inverse du graphe courant.
  */
-Graphe Graphe::grapheInverse() const {
+template <typename S, typename P>
+GrapheGenerique<S, P> GrapheGenerique<S, P>::grapheInverse() const {
 
-    Graphe inverse(listes.size()) ;
+    GrapheGenerique inverse(listes.size(), allocateur.lireArena()) ;
 
     for (size_t depart = 0; depart < listes.size(); ++depart) {
-        auto liste = listes.at(depart) ;
-        for (auto arc: liste) {
+        for (const auto& arc: listes.at(depart)) {
             inverse.ajouterArc(arc.destination, depart, arc.poids) ;
         }
     }
@@ -103,11 +162,23 @@ Graphe Graphe::grapheInverse() const {
     return inverse ;
 }
 
+/**
+ * Donne la version courante du graphe.  Elle change à chaque modification (ajout ou retrait d'un sommet ou d'un arc) et
+ * n'est jamais partagée par deux graphes différents: un résultat calculé sur une version donnée reste donc valide tant
+ * que la version n'a pas changé.  Voir CacheDijkstra.
+ * @return Le numéro de version
+ */
+template <typename S, typename P>
+uint64_t GrapheGenerique<S, P>::version() const {
+    return revision ;
+}
+
 /**
  * Donne le nombre de sommets dans le graphe.
  * @return Entier positif ou nul représentant le nombre de sommets.
  */
-size_t Graphe::taille() const {
+template <typename S, typename P>
+size_t GrapheGenerique<S, P>::taille() const {
     return listes.size() ;
 }
 
@@ -119,7 +190,8 @@ size_t Graphe::taille() const {
  * @param sommet Entier positif. Le numéro du sommet à éliminer.
  * @except std::invalid_argument si le sommet n'est pas dans le graphe
  */
-void Graphe::retirerSommet(size_t sommet) {
+template <typename S, typename P>
+void GrapheGenerique<S, P>::retirerSommet(size_t sommet) {
     if (!sommetExiste(sommet)) throw std::invalid_argument("retirerSommet: sommet inexistant") ;
 
     listes.erase(listes.begin() + static_cast<std::vector<size_t>::difference_type> (sommet)) ;
@@ -132,6 +204,7 @@ void Graphe::retirerSommet(size_t sommet) {
     for (auto& liste: listes) {
         for (auto& voisin: liste) if (voisin.destination > sommet) --voisin.destination ;
     }
+    revision = nouvelleVersion() ;
 
 }
 
@@ -141,7 +214,8 @@ void Graphe::retirerSommet(size_t sommet) {
  * @return Un entier positif ou nul représentant le nombre d'arcs partants de ce sommet
  * @except std::invalid_argument si le numéro de sommet demandé n'est pas dans le graphe
  */
-size_t Graphe::ariteSortie(size_t sommet) const {
+template <typename S, typename P>
+size_t GrapheGenerique<S, P>::ariteSortie(size_t sommet) const {
     if (!sommetExiste(sommet)) throw std::invalid_argument("ariteSortie: sommet inexistant") ;
     return listes.at(sommet).size() ;
 }
@@ -153,13 +227,30 @@ size_t Graphe::ariteSortie(size_t sommet) const {
  * @param depart Entier positif ou nul, sommet de départ de l'arête
  * @param arrivee Entier positif ou nul, sommet d'arrivée de l'arête
  */
-void Graphe::retirerArc(size_t depart, size_t arrivee) {
+template <typename S, typename P>
+void GrapheGenerique<S, P>::retirerArc(size_t depart, size_t arrivee) {
     auto& liste = listes.at(depart) ;
     auto it = std::find_if(liste.begin(), liste.end(), [&arrivee](Arc e) {return e.destination == arrivee ; }) ;
     if (it != liste.end()) liste.erase(it) ;
     else throw std::invalid_argument("retirerArc: arc inexistant") ;
+    revision = nouvelleVersion() ;
 }
 
+/**
+ * Vérifie que le type choisi pour les numéros de sommets peut représenter un graphe d'une taille donnée.  Le numéro
+ * taille() est aussi réservé: les algorithmes s'en servent pour indiquer l'absence de prédécesseur.
+ * @param nombre Nombre de sommets voulus
+ * @except std::length_error si le type de sommet est trop petit
+ */
+template <typename S, typename P>
+void GrapheGenerique<S, P>::verifierCapacite(size_t nombre) {
+    if (nombre > static_cast<size_t>(std::numeric_limits<S>::max()))
+        throw std::length_error("GrapheGenerique: trop de sommets pour le type de sommet choisi") ;
+}
 
+// Combinaisons de types offertes aux utilisateurs de la bibliothèque
 
-
+template class GrapheGenerique<size_t, double> ;
+template class GrapheGenerique<uint32_t, float> ;
+template class GrapheGenerique<uint32_t, uint32_t> ;
+template class GrapheGenerique<uint32_t, SansPoids> ;
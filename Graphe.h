@@ -9,9 +9,74 @@
 #include <vector>
 #include <list>
 #include <algorithm>
+#include <stdexcept>
+#include <memory>
+#include <cstdint>
+#include <limits>
+
+#include "ArenaArcs.h"
+
+/**
+ * @struct SansPoids Type de pondération vide, pour les graphes qui ne servent qu'aux parcours (BFS, DFS, CFC...).  Un arc
+ * d'un tel graphe ne contient que son sommet de destination.
+ */
+struct SansPoids {
+    bool operator == (SansPoids) const {return true ; }
+};
+
+/**
+ * @struct TraitsPoids Valeurs particulières d'un type de pondération: le poids par défaut d'un arc et la distance
+ * infinie utilisée par les plus courts chemins.  Pour les types entiers, qui n'ont pas d'infini, la valeur maximale
+ * en tient lieu.
+ * @tparam P Type de pondération
+ */
+template <typename P>
+struct TraitsPoids {
+    static P unite() {return P(1) ; }
+    static P infini() {
+        return std::numeric_limits<P>::has_infinity ? std::numeric_limits<P>::infinity() : std::numeric_limits<P>::max() ;
+    }
+};
+
+template <>
+struct TraitsPoids<SansPoids> {
+    static SansPoids unite() {return {} ; }
+};
+
+/**
+ * @struct ArcGenerique Chaque arête du graphe contient un sommet et une pondération.  Cette structure sert à emmagasiner
+ * ces données, sous la forme la plus compacte permise par les types choisis.
+ * @tparam S Type entier non signé servant à numéroter les sommets
+ * @tparam P Type de la pondération
+ */
+template <typename S, typename P>
+struct ArcGenerique {
+    S destination ;
+    P poids ;
+
+    ArcGenerique(size_t dest, P poids) : destination(static_cast<S>(dest)), poids(poids) {}
+    bool operator == (const ArcGenerique& rhs) const {return destination == rhs.destination && poids == rhs.poids; }
+    bool operator <  (const ArcGenerique& rhs) const {return poids < rhs.poids ; } ;
+};
 
 /**
- * @class Graphe
+ * Spécialisation pour les graphes non pondérés: la pondération n'occupe aucune place dans l'arc, mais reste accessible
+ * sous le nom poids afin que le code générique n'ait pas à distinguer les deux cas.
+ */
+template <typename S>
+struct ArcGenerique<S, SansPoids> {
+    S destination ;
+    static constexpr SansPoids poids {} ;
+
+    explicit ArcGenerique(size_t dest, SansPoids = {}) : destination(static_cast<S>(dest)) {}
+    bool operator == (const ArcGenerique& rhs) const {return destination == rhs.destination ; }
+};
+
+template <typename S>
+constexpr SansPoids ArcGenerique<S, SansPoids>::poids ;
+
+/**
+ * @class GrapheGenerique
  *
  * Cette classe représente un graphe comportant n sommets.  Chaque sommet est identifié par un entier positif consécutif
  * à-partir de 0.
@@ -19,26 +84,30 @@
  * Par-exemple, un graphe à 4 sommets contient obligatoirement les sommets: 0, 1 , 2, et 3.  Il ne peut y avoir de saut,
  * le graphe comportant des sommets 0, 1, 2, 4 et 5 ne pourrait pas exister puisque le sommet 3 serait manquant.
  *
+ * Le type des numéros de sommets et celui des pondérations sont fixés à la compilation.  L'interface publique manipule
+ * toujours des size_t; seuls les arcs emmagasinés utilisent les types compacts.  Les combinaisons offertes sont
+ * instanciées dans Graphe.cpp, voir les alias Graphe, GrapheCompact, GrapheEntier et GrapheNonPondere plus bas.
+ *
+ * @tparam S Type entier non signé servant à numéroter les sommets
+ * @tparam P Type de la pondération, ou SansPoids
  */
-class Graphe {
+template <typename S, typename P>
+class GrapheGenerique {
 public:
 
-    // Chaque arête du graphe contient un sommet et une pondération.  Cette structure sert à emmagasiner ces données.
-
-    struct Arc {
-        size_t destination ;
-        double poids ;
+    using Sommet = S ;
+    using Poids = P ;
+    using Arc = ArcGenerique<S, P> ;
 
-        Arc(size_t dest, double poids) : destination(dest), poids(poids) {}
-        bool operator == (Arc rhs) const {return destination == rhs.destination && poids == rhs.poids; }
-        bool operator <  (Arc rhs) const {return poids < rhs.poids ; } ;
-    };
+    // Les listes d'adjacence puisent leurs noeuds dans une ArenaArcs si le graphe en a reçu une, sinon dans le tas.
 
-    using Arc = struct Arc ;
+    using ListeArcs = std::list<Arc, AllocateurArcs<Arc>> ;
 
 public:
 
-    explicit              Graphe(size_t nombre = 0) ;
+    explicit              GrapheGenerique(size_t nombre = 0) ;
+
+                          GrapheGenerique(size_t nombre, std::shared_ptr<ArenaArcs> arena) ;
 
     size_t                taille()                                     const  ;
 
@@ -46,29 +115,47 @@ public:
 
     bool                  arcExiste(size_t depart, size_t destination) const ;
 
-    const std::list<Arc>& enumererVoisins(size_t depart)               const ;
+    const ListeArcs&      enumererVoisins(size_t depart)               const ;
 
     size_t                ariteEntree(size_t sommet)                   const ;
 
     size_t                ariteSortie(size_t sommet)                   const ;
 
-    Graphe                grapheInverse()                              const ;
+    GrapheGenerique       grapheInverse()                              const ;
+
+    uint64_t              version()                                    const ;
 
 
     void                  ajouterSommet() ;
 
     void                  retirerSommet(size_t sommet) ;
 
-    void                  ajouterArc(size_t depart, size_t arrivee, double poids = 1.0) ;
+    void                  ajouterArc(size_t depart, size_t arrivee, P poids = TraitsPoids<P>::unite()) ;
+
+    void                  ajouterArcDistinct(size_t depart, size_t arrivee, P poids = TraitsPoids<P>::unite()) ;
 
     void                  retirerArc(size_t depart, size_t arrivee) ;
 
 
 private:
-    
-    std::vector<std::list<Arc>> listes ;
+
+    static void           verifierCapacite(size_t nombre) ;
+
+    AllocateurArcs<Arc>    allocateur ;
+    std::vector<ListeArcs> listes ;
+    uint64_t               revision ;
 
 
 };
 
+using Graphe           = GrapheGenerique<size_t, double> ;
+using GrapheCompact    = GrapheGenerique<uint32_t, float> ;
+using GrapheEntier     = GrapheGenerique<uint32_t, uint32_t> ;
+using GrapheNonPondere = GrapheGenerique<uint32_t, SansPoids> ;
+
+extern template class GrapheGenerique<size_t, double> ;
+extern template class GrapheGenerique<uint32_t, float> ;
+extern template class GrapheGenerique<uint32_t, uint32_t> ;
+extern template class GrapheGenerique<uint32_t, SansPoids> ;
+
 #endif //SIMPLESGRAPHES_GRAPHE_H
@@ -0,0 +1,148 @@
+//
+// Created by Pascal Charpentier on 2023-07-17.
+//
+
+#include "GrapheCompresse.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+    /**
+     * Bornes des poids d'un graphe, pour la quantification.  Les types non arithmétiques n'ont pas de bornes.
+     */
+    template <typename S, typename P>
+    void bornesPoids(const GrapheGenerique<S, P>& graphe, double& minimum, double& maximum, std::true_type) {
+        minimum = std::numeric_limits<double>::infinity() ;
+        maximum = -std::numeric_limits<double>::infinity() ;
+        for (size_t sommet = 0; sommet < graphe.taille(); ++sommet)
+            for (const auto& arc: graphe.enumererVoisins(sommet)) {
+                minimum = std::min(minimum, static_cast<double>(arc.poids)) ;
+                maximum = std::max(maximum, static_cast<double>(arc.poids)) ;
+            }
+        if (minimum > maximum) minimum = maximum = 0 ;
+    }
+
+    template <typename S, typename P>
+    void bornesPoids(const GrapheGenerique<S, P>&, double& minimum, double& maximum, std::false_type) {
+        minimum = maximum = 0 ;
+    }
+
+}
+
+/**
+ * Compresse un graphe.  Le graphe d'origine n'est pas modifié et peut être détruit ensuite.
+ * @param graphe Le graphe à compresser
+ * @param bitsPoids 0 pour conserver les poids exacts, 8 ou 16 pour les quantifier.  Ignoré pour SansPoids.
+ * @except std::invalid_argument si bitsPoids ne vaut pas 0, 8 ou 16
+ */
+template <typename P>
+template <typename S>
+GrapheCompresse<P>::GrapheCompresse(const GrapheGenerique<S, P>& graphe, unsigned bitsPoids)
+    : positions(), octets(), bitsPoids(bitsPoids), minimum(0), pas(0) {
+    if (bitsPoids != 0 && bitsPoids != 8 && bitsPoids != 16)
+        throw std::invalid_argument("GrapheCompresse: bitsPoids doit valoir 0, 8 ou 16") ;
+
+    if (bitsPoids != 0) {
+        double maximum ;
+        bornesPoids(graphe, minimum, maximum, std::is_arithmetic<P>()) ;
+        pas = (maximum - minimum) / static_cast<double>((1u << bitsPoids) - 1) ;
+    }
+
+    positions.reserve(graphe.taille() + 1) ;
+    ListeTemporaire arcs ;
+    for (size_t sommet = 0; sommet < graphe.taille(); ++sommet) {
+        arcs.clear() ;
+        for (const auto& arc: graphe.enumererVoisins(sommet)) arcs.emplace_back(arc.destination, arc.poids) ;
+        ajouterListe(arcs) ;
+    }
+    fermer() ;
+}
+
+/**
+ * Construit un graphe compressé vide, à remplir par ajouterListe, avec les paramètres de quantification donnés.
+ */
+template <typename P>
+GrapheCompresse<P>::GrapheCompresse(size_t nombre, unsigned bitsPoids, double minimum, double pas)
+    : positions(), octets(), bitsPoids(bitsPoids), minimum(minimum), pas(pas) {
+    positions.reserve(nombre + 1) ;
+}
+
+/**
+ * Code les arcs du prochain sommet: l'arité, puis la première destination et les écarts suivants diminués de 1, chacun
+ * suivi de son poids.  La liste est triée au passage.
+ */
+template <typename P>
+void GrapheCompresse<P>::ajouterListe(ListeTemporaire& arcs) {
+    std::sort(arcs.begin(), arcs.end(), [](const std::pair<size_t, P>& a, const std::pair<size_t, P>& b) {
+        return a.first < b.first ;
+    }) ;
+
+    positions.push_back(octets.size()) ;
+    ecrireVarint(octets, arcs.size()) ;
+    size_t precedente = 0 ;
+    for (size_t i = 0; i < arcs.size(); ++i) {
+        ecrireVarint(octets, i == 0 ? arcs[i].first : arcs[i].first - precedente - 1) ;
+        CodecPoids<P>::coder(octets, arcs[i].second, bitsPoids, minimum, pas) ;
+        precedente = arcs[i].first ;
+    }
+}
+
+/**
+ * Termine la construction: ajoute la position de fin et rend la mémoire excédentaire.
+ */
+template <typename P>
+void GrapheCompresse<P>::fermer() {
+    positions.push_back(octets.size()) ;
+    positions.shrink_to_fit() ;
+    octets.shrink_to_fit() ;
+}
+
+/**
+ * Construit le graphe inverse, directement sous forme compressée.  Les poids quantifiés sont recodés avec les mêmes
+ * paramètres et restent donc identiques.
+ * @return Un graphe compressé dont les arcs sont ceux de l'objet, inversés
+ */
+template <typename P>
+GrapheCompresse<P> GrapheCompresse<P>::grapheInverse() const {
+    const size_t n = taille() ;
+    std::vector<size_t> debuts(n + 1, 0) ;
+    for (size_t sommet = 0; sommet < n; ++sommet)
+        for (const auto& arc: enumererVoisins(sommet)) ++ debuts[arc.destination + 1] ;
+    for (size_t sommet = 0; sommet < n; ++sommet) debuts[sommet + 1] += debuts[sommet] ;
+
+    ListeTemporaire entrants(debuts[n]) ;
+    std::vector<size_t> curseurs(debuts.begin(), debuts.end() - 1) ;
+    for (size_t sommet = 0; sommet < n; ++sommet)
+        for (const auto& arc: enumererVoisins(sommet)) entrants[curseurs[arc.destination] ++] = {sommet, arc.poids} ;
+
+    GrapheCompresse inverse(n, bitsPoids, minimum, pas) ;
+    ListeTemporaire arcs ;
+    for (size_t sommet = 0; sommet < n; ++sommet) {
+        arcs.assign(entrants.begin() + static_cast<std::ptrdiff_t>(debuts[sommet]),
+                    entrants.begin() + static_cast<std::ptrdiff_t>(debuts[sommet + 1])) ;
+        inverse.ajouterListe(arcs) ;
+    }
+    inverse.fermer() ;
+    return inverse ;
+}
+
+/**
+ * @return La mémoire occupée par le graphe compressé, en octets
+ */
+template <typename P>
+size_t GrapheCompresse<P>::octetsOccupes() const {
+    return sizeof(*this) + positions.capacity() * sizeof(uint64_t) + octets.capacity() ;
+}
+
+template class GrapheCompresse<double> ;
+template class GrapheCompresse<float> ;
+template class GrapheCompresse<uint32_t> ;
+template class GrapheCompresse<SansPoids> ;
+
+template GrapheCompresse<double>::GrapheCompresse(const GrapheGenerique<size_t, double>&, unsigned) ;
+template GrapheCompresse<float>::GrapheCompresse(const GrapheGenerique<uint32_t, float>&, unsigned) ;
+template GrapheCompresse<uint32_t>::GrapheCompresse(const GrapheGenerique<uint32_t, uint32_t>&, unsigned) ;
+template GrapheCompresse<SansPoids>::GrapheCompresse(const GrapheGenerique<uint32_t, SansPoids>&, unsigned) ;
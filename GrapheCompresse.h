@@ -0,0 +1,218 @@
+//
+// Created by Pascal Charpentier on 2023-07-17.
+//
+
+#ifndef SIMPLESGRAPHES_GRAPHECOMPRESSE_H
+#define SIMPLESGRAPHES_GRAPHECOMPRESSE_H
+
+#include "Graphe.h"
+#include "Varint.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @struct CodecPoids Codage des poids d'un GrapheCompresse.  Avec 0 bit, le poids est copié dans sa représentation
+ * native; avec 8 ou 16 bits, il est ramené à l'entier q le plus proche tel que poids = minimum + q * pas.  Les poids
+ * entiers décodés sont arrondis.  Les types non arithmétiques, comme SansPoids, ne sont pas stockés du tout.
+ */
+template <typename P, bool = std::is_arithmetic<P>::value>
+struct CodecPoids {
+    static void coder(std::vector<uint8_t>& octets, P poids, unsigned bits, double minimum, double pas) {
+        if (bits == 0) {
+            const uint8_t* brut = reinterpret_cast<const uint8_t*>(&poids) ;
+            octets.insert(octets.end(), brut, brut + sizeof(P)) ;
+            return ;
+        }
+        double echelon = pas > 0 ? std::round((static_cast<double>(poids) - minimum) / pas) : 0.0 ;
+        auto q = static_cast<uint32_t>(echelon) ;
+        octets.push_back(static_cast<uint8_t>(q)) ;
+        if (bits == 16) octets.push_back(static_cast<uint8_t>(q >> 8)) ;
+    }
+
+    static P decoder(const uint8_t*& curseur, unsigned bits, double minimum, double pas) {
+        if (bits == 0) {
+            P poids ;
+            std::memcpy(&poids, curseur, sizeof(P)) ;
+            curseur += sizeof(P) ;
+            return poids ;
+        }
+        uint32_t q = *curseur++ ;
+        if (bits == 16) q |= static_cast<uint32_t>(*curseur++) << 8 ;
+        double valeur = minimum + q * pas ;
+        return std::is_integral<P>::value ? static_cast<P>(std::llround(valeur)) : static_cast<P>(valeur) ;
+    }
+};
+
+template <typename P>
+struct CodecPoids<P, false> {
+    static void coder(std::vector<uint8_t>&, const P&, unsigned, double, double) {}
+    static P decoder(const uint8_t*&, unsigned, double, double) {return P {} ; }
+};
+
+/**
+ * @class GrapheCompresse
+ *
+ * Représentation compacte et en lecture seule d'un graphe, pour les graphes trop gros pour des listes d'adjacence.  Les
+ * voisins de chaque sommet sont triés puis codés en écarts successifs, chaque écart en varint (voir Varint.h).  Des
+ * voisins proches, après une renumérotation comme ordreCuthillMcKeeInverse, ne coûtent ainsi qu'un octet par arc.  Le
+ * poids suit chaque écart: en représentation native, ou quantifié sur 8 ou 16 bits entre le poids minimal et le poids
+ * maximal du graphe.  Un graphe SansPoids ne stocke aucun poids.
+ *
+ * L'interface de lecture imite celle de GrapheGenerique (taille, ariteSortie, enumererVoisins, grapheInverse): les
+ * algorithmes qui ne font que parcourir les arcs, comme exploreBFS, kosaraju et pageRank, s'appliquent donc aussi à un
+ * GrapheCompresse.  enumererVoisins retourne une vue décodée à la volée, dans l'ordre croissant des destinations.
+ *
+ * @tparam P Type de la pondération, ou SansPoids
+ */
+template <typename P>
+class GrapheCompresse {
+public:
+
+    /**
+     * @struct Arc Un arc décodé.
+     */
+    struct Arc {
+        size_t destination ;
+        P poids ;
+    };
+
+    class Iterateur ;
+    class Voisins ;
+
+    template <typename S>
+    explicit              GrapheCompresse(const GrapheGenerique<S, P>& graphe, unsigned bitsPoids = 0) ;
+
+    size_t                taille()                                     const {return positions.size() - 1 ; }
+
+    bool                  sommetExiste(size_t numero)                  const {return numero < taille() ; }
+
+    size_t                ariteSortie(size_t sommet)                   const ;
+
+    Voisins               enumererVoisins(size_t depart)               const ;
+
+    GrapheCompresse       grapheInverse()                              const ;
+
+    size_t                octetsOccupes()                              const ;
+
+private:
+
+    using ListeTemporaire = std::vector<std::pair<size_t, P>> ;
+
+    GrapheCompresse(size_t nombre, unsigned bitsPoids, double minimum, double pas) ;
+
+    void                  ajouterListe(ListeTemporaire& arcs) ;
+
+    void                  fermer() ;
+
+    P                     decoderPoids(const uint8_t*& curseur)       const ;
+
+    std::vector<uint64_t> positions ;
+    std::vector<uint8_t>  octets ;
+    unsigned              bitsPoids ;
+    double                minimum ;
+    double                pas ;
+
+};
+
+/**
+ * @class GrapheCompresse::Iterateur Itérateur d'entrée sur les arcs d'un sommet, qui décode un arc à chaque avancée.
+ */
+template <typename P>
+class GrapheCompresse<P>::Iterateur {
+public:
+    using iterator_category = std::input_iterator_tag ;
+    using value_type        = Arc ;
+    using difference_type   = std::ptrdiff_t ;
+    using pointer           = const Arc* ;
+    using reference         = const Arc& ;
+
+    Iterateur(const GrapheCompresse* graphe, const uint8_t* curseur, size_t restants)
+        : graphe(graphe), curseur(curseur), restants(restants), courant {0, P {}} {
+        if (restants > 0) {
+            courant.destination = lireVarint(this->curseur) ;
+            courant.poids = graphe->decoderPoids(this->curseur) ;
+        }
+    }
+
+    const Arc& operator * ()                                    const {return courant ; }
+    const Arc* operator -> ()                                   const {return &courant ; }
+
+    Iterateur& operator ++ () {
+        if (-- restants > 0) {
+            courant.destination += lireVarint(curseur) + 1 ;
+            courant.poids = graphe->decoderPoids(curseur) ;
+        }
+        return *this ;
+    }
+
+    bool operator == (const Iterateur& rhs)                     const {return restants == rhs.restants ; }
+    bool operator != (const Iterateur& rhs)                     const {return restants != rhs.restants ; }
+
+private:
+    const GrapheCompresse* graphe ;
+    const uint8_t*         curseur ;
+    size_t                 restants ;
+    Arc                    courant ;
+};
+
+/**
+ * @class GrapheCompresse::Voisins Vue sur les arcs d'un sommet, parcourable par une boucle for à intervalle.
+ */
+template <typename P>
+class GrapheCompresse<P>::Voisins {
+public:
+    Voisins(const GrapheCompresse* graphe, const uint8_t* debut, size_t nombre)
+        : graphe(graphe), debut(debut), nombre(nombre) {}
+
+    Iterateur begin()                                           const {return Iterateur(graphe, debut, nombre) ; }
+    Iterateur end()                                             const {return Iterateur(graphe, nullptr, 0) ; }
+    size_t    size()                                            const {return nombre ; }
+    bool      empty()                                           const {return nombre == 0 ; }
+
+private:
+    const GrapheCompresse* graphe ;
+    const uint8_t*         debut ;
+    size_t                 nombre ;
+};
+
+/**
+ * Décode le poids qui suit une destination et avance le curseur.
+ */
+template <typename P>
+inline P GrapheCompresse<P>::decoderPoids(const uint8_t*& curseur) const {
+    return CodecPoids<P>::decoder(curseur, bitsPoids, minimum, pas) ;
+}
+
+/**
+ * @param sommet Numéro du sommet
+ * @return Le nombre d'arcs qui en sortent
+ */
+template <typename P>
+inline size_t GrapheCompresse<P>::ariteSortie(size_t sommet) const {
+    const uint8_t* curseur = octets.data() + positions.at(sommet) ;
+    return lireVarint(curseur) ;
+}
+
+/**
+ * @param depart Numéro du sommet
+ * @return Une vue sur ses arcs sortants, triés par destination
+ * @except std::out_of_range si le sommet n'existe pas
+ */
+template <typename P>
+inline typename GrapheCompresse<P>::Voisins GrapheCompresse<P>::enumererVoisins(size_t depart) const {
+    const uint8_t* curseur = octets.data() + positions.at(depart) ;
+    size_t nombre = lireVarint(curseur) ;
+    return Voisins(this, curseur, nombre) ;
+}
+
+extern template class GrapheCompresse<double> ;
+extern template class GrapheCompresse<float> ;
+extern template class GrapheCompresse<uint32_t> ;
+extern template class GrapheCompresse<SansPoids> ;
+
+#endif //SIMPLESGRAPHES_GRAPHECOMPRESSE_H
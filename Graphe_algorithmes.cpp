@@ -3,6 +3,14 @@
 //
 
 #include "Graphe_algorithmes.h"
+#include "RelaxationBloc.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <random>
 
 /**
  * @namespace anonyme: comprend un type et des fonctions privées à ce fichier.  Ce sont des fonctions auxiliaires servant
@@ -16,7 +24,8 @@ namespace {
  * Elle permet d'alléger l'écriture de la fonction auxExploreRecursifDFS qui explore en profondeur un graphe à partir d'un sommet
  * donné.  Elle contient les champs suivants:
  *
- * graphe: l'objet graphe que l'on parcourt.
+ * graphe: une référence vers l'objet graphe que l'on parcourt.  Le graphe n'est jamais copié, il doit donc survivre
+ * à la structure InfoDFS.
  *
  * abandonnes: une pile contenant les sommets ayant été visités, en ordre d'abandon.  C'est donc le résultat principal d'une
  * exploration en profondeur.
@@ -35,16 +44,18 @@ namespace {
  *
  * Par-contre, dépendemment de l'algorithme, la pile abandonnes peu ou non être modifiée: si on veut seulement explorer
  * le graphe au complet, comme dans exploreRecursifGrapheDFS, on ne touche pas à la pile puisqu'on veut accumuler tous les noeuds
- * du graphe éventuellement.  Si on veut connaître les CFC, comme dans kosaraju, alors il faut vider la pile abandonnes
- * entre chaque appel, puisque après un appel à auxExploreRecursifDFS, la pile contient une CFC.
+ * du graphe éventuellement.  Si on veut des arborescences séparées, alors il faut vider la pile abandonnes entre chaque
+ * appel.  Les algorithmes qui doivent tenir sur de grands graphes (kosaraju) utilisent plutôt ParcoursProfondeur, qui
+ * n'est pas récursif.
  */
 
-    using InfoDFS =  struct infoDFS {
-        Graphe graphe ;
+    template <typename G>
+    struct InfoDFS {
+        const G& graphe ;
         std::stack<size_t> abandonnes ;
         std::vector<bool> visites ;
 
-        explicit infoDFS(const Graphe& g) : graphe(g), abandonnes(), visites(g.taille(), false) {}
+        explicit InfoDFS(const G& g) : graphe(g), abandonnes(), visites(g.taille(), false) {}
     } ;
 
     /**
@@ -54,8 +65,9 @@ namespace {
      * @param distances Vecteur comprenant les distances mises à jour.
      * @return Le numéro du prochain sommet résolu.
      */
-    size_t localiserSommetMinimal(std::set<size_t> nonResolus, std::vector<double> distances) {
-        auto temp = std::numeric_limits<double>::infinity() ;
+    template <typename P>
+    size_t localiserSommetMinimal(const std::set<size_t>& nonResolus, const std::vector<P>& distances) {
+        auto temp = TraitsPoids<P>::infini() ;
         size_t indexMin = *nonResolus.begin();
 
         for (auto cle: nonResolus)
@@ -66,35 +78,6 @@ namespace {
         return indexMin ;
     }
 
-    /**
-     * Relaxe le noeud voisin à partir du noeud courant.
-     * @param voisin struct Arc un noeud adjacent au noeud courant
-     * @param courant le numéro du sommet courant
-     * @param res struct ResultatDijkstra comprenant les distances et les prédécesseurs. Mis à jour lors de la relaxation.
-     */
-    void relaxer(const Graphe::Arc& voisin, size_t courant, ResultatsDijkstra& res) {
-        double temp = res.distances.at(courant) + voisin.poids ;
-        if (temp < res.distances.at(voisin.destination)) {
-            res.distances.at(voisin.destination) = temp ;
-            res.predecesseurs.at(voisin.destination) = courant ;
-        }
-    }
-
-    /**
-     * Relaxe le noeud voisin à partir du noeud courant, utilisant une file prioritaire pour les distances
-     * @param voisin struct Arc, noeud voisin
-     * @param courant Numéro du noeud courant
-     * @param resultat Dans cette structure, les prédécesseurs seront mis à jour
-     * @param nonResolus dans cette structure les distances seront mises à jour
-     */
-    void relaxerFilePrioritaire(Graphe::Arc voisin, size_t courant, ResultatsDijkstra& resultat, FilePrioritaire<double>& nonResolus) {
-        double temp = nonResolus.lireClePourIndex(courant) + voisin.poids ;
-        if (temp < nonResolus.lireClePourIndex(voisin.destination)) {
-            nonResolus.reduireCle(voisin.destination, temp) ;
-            resultat.predecesseurs.at(voisin.destination) = courant ;
-        }
-    }
-
     /**
      * Transfère le contenu d'une pile dans un set, en vidant la pile.
      * @tparam T Type d'éléments de la pile
@@ -122,7 +105,8 @@ namespace {
      * @pre ATTENTION: Si le numéro de sommet est non-valide, le comportement
      * sera non défini.  La validité du paramètre départ est la responsabilité de l'appeleur!!!
      */
-    void auxExploreRecursifDFS(InfoDFS& donneesDFS, size_t depart) {
+    template <typename G>
+    void auxExploreRecursifDFS(InfoDFS<G>& donneesDFS, size_t depart) {
         if (donneesDFS.visites.at(depart)) return ;
 
         donneesDFS.visites.at(depart) = true ;
@@ -133,6 +117,84 @@ namespace {
 
     }
 
+    /**
+     * Corps de exploreRecursifGrapheDFS, pour tout type de graphe offrant taille et enumererVoisins: GrapheGenerique
+     * ou GrapheCompresse.
+     */
+    template <typename G>
+    std::stack<size_t> profondeurComplete(const G& graphe) {
+        InfoDFS<G> donneesDfs(graphe) ;
+
+        for (size_t depart = 0; depart < graphe.taille(); ++depart)
+            auxExploreRecursifDFS(donneesDfs, depart) ;
+
+        return std::move(donneesDfs.abandonnes) ;
+    }
+
+    /**
+     * Corps de exploreBFS, pour tout type de graphe.
+     */
+    template <typename G>
+    std::vector<size_t> largeurDepuis(const G& graphe, size_t depart) {
+        if (!graphe.sommetExiste(depart)) throw std::invalid_argument("exploreBFS: sommet invalide ou graphe vide") ;
+
+        std::vector<size_t> predecesseurs(graphe.taille(), graphe.taille()) ;
+        std::queue<size_t> attente ;
+        std::vector<bool> visites(graphe.taille(), false) ;
+        visites.at(depart) = true ;
+
+        attente.push(depart) ;
+
+        while (!attente.empty()) {
+            auto courant = attente.front() ;
+            attente.pop() ;
+
+            for (const auto& voisin: graphe.enumererVoisins(courant)) {
+                if (!visites.at(voisin.destination)) {
+                    attente.push(voisin.destination) ;
+                    visites.at(voisin.destination) = true ;
+                    predecesseurs.at(voisin.destination) = courant ;
+                }
+            }
+        }
+        return predecesseurs ;
+    }
+
+    /**
+     * Visiteur qui empile les sommets dans l'ordre où ils sont abandonnés.
+     */
+    struct VisiteurAbandons : VisiteurProfondeur {
+        std::stack<size_t> abandonnes ;
+
+        void terminer(size_t sommet, size_t) {abandonnes.push(sommet) ; }
+    };
+
+    /**
+     * Corps de kosaraju, pour tout type de graphe.  Les deux passes sont itératives: la profondeur des composantes
+     * n'est pas limitée par la pile d'appels.
+     */
+    template <typename G>
+    std::set<std::set<size_t>> composantesKosaraju(const G& graphe) {
+        std::set<std::set<size_t>> composantes ;
+
+        const G inverse = graphe.grapheInverse() ;
+        VisiteurAbandons ordre ;
+        parcourirProfondeur(inverse, ordre) ;
+
+        ParcoursProfondeur<G> parcours(graphe) ;
+        VisiteurAbandons composante ;
+        while (!ordre.abandonnes.empty()) {
+            size_t depart = ordre.abandonnes.top() ;
+            ordre.abandonnes.pop() ;
+
+            if (!parcours.decouvert(depart)) {
+                parcours.explorer(depart, composante) ; // La CFC résultante sera stockée dans la pile composante.abandonnes
+                composantes.insert(transfererPileVersSet<size_t>(composante.abandonnes)) ; // La pile est vidée et transférée
+            }
+        }
+
+        return composantes ;
+    }
 
 }
 
@@ -144,13 +206,9 @@ namespace {
  * @return Un pile contenant les noeuds dans l'ordre où ils ont été abandonnés.  Donc le dernier noeud abandonné sera le
  * premier à sortir de la pile.
  */
-std::stack<size_t> exploreRecursifGrapheDFS(const Graphe &graphe) {
-    InfoDFS donneesDfs(graphe) ;
-
-    for (size_t depart = 0; depart < graphe.taille(); ++depart)
-        auxExploreRecursifDFS(donneesDfs, depart) ;
-
-    return donneesDfs.abandonnes ;
+template <typename S, typename P>
+std::stack<size_t> exploreRecursifGrapheDFS(const GrapheGenerique<S, P>& graphe) {
+    return profondeurComplete(graphe) ;
 }
 
 /**
@@ -162,86 +220,56 @@ std::stack<size_t> exploreRecursifGrapheDFS(const Graphe &graphe) {
  * du départ.  L'absence de prédécesseur est indiquée par la valeur graphe.taille() qui ne correspond à aucun sommet.
  * @except std::invalid_argument si le numéro de départ n'est pas dans le graphe, ou si le graphe est vide
  */
-std::vector<size_t> exploreBFS(const Graphe &graphe, size_t depart) {
-    if (!graphe.sommetExiste(depart)) throw std::invalid_argument("exploreBFS: sommet invalide ou graphe vide") ;
-
-    std::vector<size_t> predecesseurs(graphe.taille(), graphe.taille()) ;
-    std::queue<size_t> attente ;
-    std::vector<bool> visites(graphe.taille(), false) ;
-    visites.at(depart) = true ;
-
-    attente.push(depart) ;
-
-    while (!attente.empty()) {
-        auto courant = attente.front() ;
-        attente.pop() ;
+template <typename S, typename P>
+std::vector<size_t> exploreBFS(const GrapheGenerique<S, P>& graphe, size_t depart) {
+    return largeurDepuis(graphe, depart) ;
+}
 
-        for (auto voisin: graphe.enumererVoisins(courant)) {
-            if (!visites.at(voisin.destination)) {
-                attente.push(voisin.destination) ;
-                visites.at(voisin.destination) = true ;
-                predecesseurs.at(voisin.destination) = courant ;
-            }
-        }
-    }
-    return predecesseurs ;
+/**
+ * Visite en largeur d'un graphe compressé, identique à celle d'un GrapheGenerique.  Les voisins étant décodés en ordre
+ * croissant, les prédécesseurs peuvent différer de ceux du graphe d'origine lorsque plusieurs sont possibles.
+ * @param graphe Le graphe compressé à explorer
+ * @param depart Le numéro du sommet de départ
+ * @return Le prédécesseur de chaque sommet, ou graphe.taille() s'il n'est pas accessible
+ * @except std::invalid_argument si le numéro de départ n'est pas dans le graphe, ou si le graphe est vide
+ */
+template <typename P>
+std::vector<size_t> exploreBFS(const GrapheCompresse<P>& graphe, size_t depart) {
+    return largeurDepuis(graphe, depart) ;
 }
 
 /**
- * Explore un objet graphe en profondeur à partir d'un sommet de départ.
+ * Explore un objet graphe en profondeur à partir d'un sommet de départ, sans récursion (voir ParcoursProfondeur).
  * @param graphe Objet graphe à visiter
  * @param depart Entier positif ou nul désignant le sommet de départ
  * @return La piles des sommets abandonnés.
+ * @except std::invalid_argument si le sommet de départ n'est pas dans le graphe
  */
-std::stack<size_t> exploreIteratifDFS(const Graphe& graphe, size_t depart) {
-    std::stack<size_t> abandonnes ;
-    std::stack<size_t> encours ;
-    std::vector<bool> visites(graphe.taille(), false) ;
-
-    encours.push(depart) ;
-    visites.at(depart) = true ;
-
-    while (!encours.empty()) {
-        auto courant = encours.top() ;
-        encours.pop() ;
-        auto liste = graphe.enumererVoisins(courant) ;
-        auto it = std::find_if(liste.begin(), liste.end(), [&visites](Graphe::Arc e){return !visites[e.destination];}) ;
-        while ( it != liste.end()) {
-            encours.push(courant) ;
-            courant = it->destination ;
-            visites.at(courant) = true ;
-            liste = graphe.enumererVoisins(courant) ;
-            it = std::find_if(liste.begin(), liste.end(), [&visites](Graphe::Arc e){return !visites[e.destination];}) ;
-        }
-        abandonnes.push(courant) ;
-    }
-    return abandonnes ;
+template <typename S, typename P>
+std::stack<size_t> exploreIteratifDFS(const GrapheGenerique<S, P>& graphe, size_t depart) {
+    VisiteurAbandons visiteur ;
+    parcourirProfondeur(graphe, depart, visiteur) ;
+    return std::move(visiteur.abandonnes) ;
 }
 
-
-
 /**
  * Énumère les composantes fortement connexes d'un graphe.
  * @param graphe Objet graphe à analyser
  * @return Un set.  Chaque élément de ce set est lui-même un set contenant les sommets d'une composante fortement connexe.
  */
-std::set<std::set<size_t>> kosaraju(const Graphe& graphe) {
-    std::set<std::set<size_t>> composantes ;
-
-    std::stack<size_t> pile = exploreRecursifGrapheDFS(graphe.grapheInverse()) ;
-
-    InfoDFS data(graphe) ;
-    while (!pile.empty()) {
-        size_t depart = pile.top() ;
-        pile.pop() ;
-
-        if (!data.visites.at(depart)) {
-            auxExploreRecursifDFS(data, depart) ; // La CFC résultante sera stockée dans la pile data.abandonnes
-            composantes.insert(transfererPileVersSet<size_t>(data.abandonnes)) ; // La pile est vidée et transférée
-        }
-    }
+template <typename S, typename P>
+std::set<std::set<size_t>> kosaraju(const GrapheGenerique<S, P>& graphe) {
+    return composantesKosaraju(graphe) ;
+}
 
-    return composantes ;
+/**
+ * Énumère les composantes fortement connexes d'un graphe compressé.
+ * @param graphe Le graphe compressé à analyser
+ * @return Un set contenant un set de sommets par composante fortement connexe
+ */
+template <typename P>
+std::set<std::set<size_t>> kosaraju(const GrapheCompresse<P>& graphe) {
+    return composantesKosaraju(graphe) ;
 }
 
 /**
@@ -251,7 +279,8 @@ std::set<std::set<size_t>> kosaraju(const Graphe& graphe) {
  * @return Un vecteur comprenant les numéros de sommet dans l'ordre topologique
  * @except std::invalid_argument si le graphe est cyclique
  */
-std::vector<size_t> triTopologique(const Graphe& graphe) {
+template <typename S, typename P>
+std::vector<size_t> triTopologique(const GrapheGenerique<S, P>& graphe) {
     std::vector<size_t> arites(graphe.taille()) ;
     std::queue<size_t> en_attente ;
     std::vector<size_t> tri ;
@@ -262,7 +291,7 @@ std::vector<size_t> triTopologique(const Graphe& graphe) {
     while (!en_attente.empty()) {
         auto courant = en_attente.front() ;
         en_attente.pop() ;
-        for (auto voisin: graphe.enumererVoisins(courant)) {
+        for (const auto& voisin: graphe.enumererVoisins(courant)) {
             -- arites.at(voisin.destination) ;
             if (arites.at(voisin.destination) == 0) en_attente.push(voisin.destination) ;
         }
@@ -280,9 +309,11 @@ std::vector<size_t> triTopologique(const Graphe& graphe) {
  * @return Un struct contenant un vecteur de prédécesseurs, permettant de reconstituer les chemins, et un vecteur des
  * distances.
  * @pre Le sommet départ doit se trouver dans le graphe, sinon le comportement est non défini.
+ * @pre Les pondérations doivent être positives ou nulles; sinon, utiliser bellmanFord.
  */
-ResultatsDijkstra dijkstra(const Graphe& graphe, size_t depart) {
-    ResultatsDijkstra resultats(graphe.taille(), depart) ;
+template <typename S, typename P>
+ResultatsDijkstraGenerique<P> dijkstra(const GrapheGenerique<S, P>& graphe, size_t depart) {
+    ResultatsDijkstraGenerique<P> resultats(graphe.taille(), depart) ;
 
     std::set<size_t> nonResolus ;
     for (size_t i = 0; i < graphe.taille(); ++i) nonResolus.insert(i) ;
@@ -290,28 +321,1374 @@ ResultatsDijkstra dijkstra(const Graphe& graphe, size_t depart) {
     while (!nonResolus.empty()) {
         auto courant = localiserSommetMinimal(nonResolus, resultats.distances) ;
         nonResolus.erase(courant) ;
-        for (auto voisin: graphe.enumererVoisins(courant)) relaxer(voisin, courant, resultats) ;
+        relaxerVoisins(graphe, courant, resultats.distances, [&resultats, courant](size_t voisin, P distance) {
+            resultats.distances[voisin] = distance ;
+            resultats.predecesseurs[voisin] = courant ;
+        }) ;
     }
     return resultats ;
 }
 
 
 /**
- * Même algorithme que la fonction précédente, mais version plus efficace utilisant une file prioritaire.
+ * Même algorithme que la fonction précédente, mais version plus efficace utilisant une file prioritaire.  Les distances
+ * sont tenues à jour dans le résultat en parallèle de la file, afin que les voisins soient relaxés par blocs (voir
+ * RelaxationBloc.h): seules les améliorations touchent à la file.
  * @param graphe Objet graphe à analyser
  * @param depart Numéro du sommet de départ
  * @return Un struct contenant un vecteur de prédécesseurs et un vecteur de distances
  * @pre Le sommet de départ doit se trouver dans le graphe, sinon le comportement est non-défini
+ * @pre Les pondérations doivent être positives ou nulles; sinon, utiliser bellmanFord.
  */
-ResultatsDijkstra dijkstraFilePrioritaire(const Graphe& graphe, size_t depart) {
-    ResultatsDijkstra resultats(graphe.taille(), depart) ;
+template <typename S, typename P>
+ResultatsDijkstraGenerique<P> dijkstraFilePrioritaire(const GrapheGenerique<S, P>& graphe, size_t depart) {
+    ResultatsDijkstraGenerique<P> resultats(graphe.taille(), depart) ;
 
-    FilePrioritaire<double> nonResolus(resultats.distances) ;
+    FilePrioritaire<P> nonResolus(resultats.distances) ;
     while (!nonResolus.estVide()) {
         auto courant = nonResolus.lireIndexMinimum() ;
         nonResolus.extraireMinimum() ;
-        for (auto voisin: graphe.enumererVoisins(courant)) relaxerFilePrioritaire(voisin, courant, resultats, nonResolus) ;
+        relaxerVoisins(graphe, courant, resultats.distances, [&resultats, &nonResolus, courant](size_t voisin, P distance) {
+            resultats.distances[voisin] = distance ;
+            resultats.predecesseurs[voisin] = courant ;
+            nonResolus.reduireCle(voisin, distance) ;
+        }) ;
+    }
+    return resultats ;
+}
+
+namespace {
+
+    /**
+     * Coeur de Bellman-Ford, commun à bellmanFord et au calcul des potentiels de Johnson.  Voir bellmanFord pour la
+     * description de l'algorithme.
+     * @param graphe Objet graphe à analyser
+     * @param resultats Distances et prédécesseurs initiaux; mis à jour en place
+     * @param listeActifs Sommets dont la distance initiale est connue, actifs au premier tour
+     * @param reservoir Réservoir de fils utilisé pour paralléliser chaque tour
+     * @param appelant Nom de la fonction publique appelante, en tête des messages d'erreur
+     * @except std::invalid_argument si un cycle de poids négatif est accessible à partir des sommets actifs
+     */
+    template <typename S, typename P>
+    void relaxerParTours(const GrapheGenerique<S, P>& graphe, ResultatsDijkstraGenerique<P>& resultats,
+                         std::vector<size_t> listeActifs, ReservoirFils& reservoir, const char* appelant) {
+        const size_t n = graphe.taille() ;
+        const GrapheGenerique<S, P> inverse = graphe.grapheInverse() ;
+
+        std::vector<P> precedentes(resultats.distances) ;
+        std::vector<char> actifs(n, 0), candidats(n, 0), ameliores(n, 0) ;
+        std::vector<size_t> listeCandidats ;
+        for (auto actif: listeActifs) actifs.at(actif) = 1 ;
+
+        for (size_t tour = 0; !listeActifs.empty(); ++tour) {
+            if (tour >= n) throw std::invalid_argument(std::string(appelant) + ": cycle de poids négatif") ;
+
+            // Seuls les successeurs qu'un arc actif améliore sont recalculés.  En début de tour, precedentes est égal
+            // à resultats.distances.
+            listeCandidats.clear() ;
+            for (auto actif: listeActifs)
+                relaxerVoisins(graphe, actif, precedentes, [&candidats, &listeCandidats](size_t voisin, P) {
+                    if (!candidats[voisin]) {
+                        candidats[voisin] = 1 ;
+                        listeCandidats.push_back(voisin) ;
+                    }
+                }) ;
+
+            reservoir.repartir(listeCandidats.size(), [&](size_t debut, size_t fin, size_t) {
+                for (size_t i = debut; i < fin; ++i) {
+                    size_t sommet = listeCandidats[i] ;
+                    P meilleure = resultats.distances[sommet] ;
+                    size_t predecesseur = resultats.predecesseurs[sommet] ;
+                    for (const auto& arc: inverse.enumererVoisins(sommet)) {
+                        if (!actifs[arc.destination]) continue ;
+                        P candidate = precedentes[arc.destination] + arc.poids ;
+                        if (candidate < meilleure) {
+                            meilleure = candidate ;
+                            predecesseur = arc.destination ;
+                        }
+                    }
+                    ameliores[sommet] = meilleure < resultats.distances[sommet] ;
+                    resultats.distances[sommet] = meilleure ;
+                    resultats.predecesseurs[sommet] = predecesseur ;
+                }
+            }, 256) ;
+
+            for (auto actif: listeActifs) actifs[actif] = 0 ;
+            listeActifs.clear() ;
+            for (auto sommet: listeCandidats) {
+                candidats[sommet] = 0 ;
+                if (ameliores[sommet]) {
+                    actifs[sommet] = 1 ;
+                    precedentes[sommet] = resultats.distances[sommet] ;
+                    listeActifs.push_back(sommet) ;
+                }
+            }
+        }
+    }
+
+    /**
+     * Première étape de Johnson: calcule les potentiels h par Bellman-Ford, comme si un sommet virtuel était relié à
+     * tous les sommets par un arc de poids nul (toutes les distances partent donc de 0), puis construit le graphe
+     * repondéré w'(u, v) = w(u, v) + h(u) - h(v), dont tous les poids sont positifs ou nuls.
+     * @param graphe Objet graphe à repondérer
+     * @param potentiels Reçoit les potentiels h
+     * @param reservoir Réservoir de fils utilisé par Bellman-Ford
+     * @param appelant Nom de la fonction publique appelante, en tête des messages d'erreur
+     * @return Le graphe repondéré
+     * @except std::invalid_argument si le graphe contient un cycle de poids négatif
+     */
+    template <typename S, typename P>
+    GrapheGenerique<S, P> repondererJohnson(const GrapheGenerique<S, P>& graphe, std::vector<P>& potentiels,
+                                            ReservoirFils& reservoir, const char* appelant) {
+        const size_t n = graphe.taille() ;
+        if (n == 0) return GrapheGenerique<S, P>(0) ;
+
+        ResultatsDijkstraGenerique<P> resultats(n, 0) ;
+        std::fill(resultats.distances.begin(), resultats.distances.end(), P(0)) ;
+        std::vector<size_t> tous(n) ;
+        std::iota(tous.begin(), tous.end(), 0) ;
+        relaxerParTours(graphe, resultats, std::move(tous), reservoir, appelant) ;
+        potentiels = std::move(resultats.distances) ;
+
+        GrapheGenerique<S, P> repondere(n) ;
+        for (size_t depart = 0; depart < n; ++depart)
+            for (const auto& arc: graphe.enumererVoisins(depart)) {
+                P poids = arc.poids + potentiels[depart] - potentiels[arc.destination] ;
+                repondere.ajouterArcDistinct(depart, arc.destination, poids < P(0) ? P(0) : poids) ;
+            }
+        return repondere ;
+    }
+
+    /**
+     * Seconde étape de Johnson: lance Dijkstra à partir de chaque sommet du graphe repondéré, en parallèle, et remet
+     * chaque ligne de distances à l'échelle originale: d(u, v) = d'(u, v) - h(u) + h(v).
+     * @param repondere Graphe repondéré
+     * @param potentiels Potentiels h
+     * @param reservoir Réservoir de fils
+     * @param consommateur Appelé comme consommateur(source, resultats) par le fil qui a traité la source
+     */
+    template <typename S, typename P, typename Consommateur>
+    void dijkstraToutesSources(const GrapheGenerique<S, P>& repondere, const std::vector<P>& potentiels,
+                               ReservoirFils& reservoir, Consommateur&& consommateur) {
+        reservoir.repartir(repondere.taille(), [&](size_t debut, size_t fin, size_t) {
+            for (size_t source = debut; source < fin; ++source) {
+                auto resultats = dijkstraFilePrioritaire(repondere, source) ;
+                for (size_t v = 0; v < resultats.distances.size(); ++v)
+                    if (resultats.distances[v] != TraitsPoids<P>::infini())
+                        resultats.distances[v] = resultats.distances[v] - potentiels[source] + potentiels[v] ;
+                consommateur(source, resultats) ;
+            }
+        }) ;
+    }
+
+}
+
+/**
+ * Algorithme de Bellman-Ford, qui accepte les pondérations négatives.  Les distances sont calculées par tours
+ * successifs: au tour k, chaque sommet tire (pull) sa nouvelle distance de ses prédécesseurs dans le graphe inverse, à
+ * partir des distances du tour précédent.  Comme dans SPFA, seuls les sommets dont la distance a changé au tour
+ * précédent (les actifs) sont considérés, et seuls ceux de leurs successeurs qu'ils améliorent sont recalculés; ce
+ * filtre passe par relaxerVoisins, donc par blocs (voir RelaxationBloc.h).  Chaque sommet recalculé n'écrit
+ * que ses propres distance et prédécesseur, ce qui permet de répartir un tour entre les fils du réservoir sans verrou.
+ * @param graphe Objet graphe à analyser
+ * @param depart Numéro du sommet de départ
+ * @param reservoir Réservoir de fils utilisé pour paralléliser chaque tour
+ * @return Un struct contenant un vecteur de prédécesseurs et un vecteur de distances
+ * @except std::invalid_argument si le départ n'est pas dans le graphe
+ * @except std::invalid_argument si un cycle de poids négatif est accessible à partir du départ
+ */
+template <typename S, typename P>
+ResultatsDijkstraGenerique<P> bellmanFord(const GrapheGenerique<S, P>& graphe, size_t depart, ReservoirFils& reservoir) {
+    if (!graphe.sommetExiste(depart)) throw std::invalid_argument("bellmanFord: sommet invalide") ;
+
+    ResultatsDijkstraGenerique<P> resultats(graphe.taille(), depart) ;
+    relaxerParTours(graphe, resultats, {depart}, reservoir, "bellmanFord") ;
+    return resultats ;
+}
+
+/**
+ * Algorithme de Johnson: plus courts chemins entre toutes les paires de sommets d'un graphe creux, pondérations
+ * négatives permises.  Le graphe est repondéré à l'aide des potentiels de Bellman-Ford, puis Dijkstra est lancé à
+ * partir de chaque source, les sources étant réparties entre les fils du réservoir.
+ * @param graphe Objet graphe à analyser
+ * @param avecPredecesseurs Si true, la matrice des prédécesseurs est aussi produite
+ * @param reservoir Réservoir de fils
+ * @return Les matrices des distances et, au besoin, des prédécesseurs
+ * @except std::invalid_argument si le graphe contient un cycle de poids négatif
+ */
+template <typename S, typename P>
+ResultatsJohnson<S, P> johnson(const GrapheGenerique<S, P>& graphe, bool avecPredecesseurs, ReservoirFils& reservoir) {
+    const size_t n = graphe.taille() ;
+    ResultatsJohnson<S, P> matrices(n, avecPredecesseurs) ;
+
+    std::vector<P> potentiels ;
+    const GrapheGenerique<S, P> repondere = repondererJohnson(graphe, potentiels, reservoir, "johnson") ;
+
+    dijkstraToutesSources(repondere, potentiels, reservoir, [&matrices, n](size_t source, const ResultatsDijkstraGenerique<P>& ligne) {
+        std::copy(ligne.distances.begin(), ligne.distances.end(), matrices.distances.begin() + static_cast<std::ptrdiff_t>(source * n)) ;
+        if (!matrices.predecesseurs.empty())
+            for (size_t v = 0; v < n; ++v) matrices.predecesseurs[source * n + v] = static_cast<S>(ligne.predecesseurs[v]) ;
+    }) ;
+
+    return matrices ;
+}
+
+/**
+ * Même algorithme que la fonction précédente, mais la matrice des distances est écrite dans un fichier au fur et à
+ * mesure, ligne par ligne, plutôt que d'être gardée en mémoire.  Chaque fil ne tient qu'une ligne à la fois, ce qui
+ * permet de produire des matrices plus grandes que la mémoire vive.
+ *
+ * Format du fichier (binaire, boutisme de la machine): le nombre de sommets n sur 64 bits, puis les n * n distances de
+ * type P, ligne par ligne: la distance de u vers v se trouve à la position n * u + v.
+ *
+ * @param graphe Objet graphe à analyser
+ * @param chemin Nom du fichier à créer; un fichier existant est écrasé
+ * @param reservoir Réservoir de fils
+ * @except std::invalid_argument si le graphe contient un cycle de poids négatif; le fichier n'est alors pas touché
+ * @except std::runtime_error si le fichier ne peut être écrit
+ */
+template <typename S, typename P>
+void johnsonVersFichier(const GrapheGenerique<S, P>& graphe, const std::string& chemin, ReservoirFils& reservoir) {
+    const uint64_t n = graphe.taille() ;
+
+    // Un cycle négatif est détecté avant d'ouvrir le fichier, qui reste alors intact.
+    std::vector<P> potentiels ;
+    const GrapheGenerique<S, P> repondere = repondererJohnson(graphe, potentiels, reservoir, "johnsonVersFichier") ;
+
+    std::ofstream fichier(chemin, std::ios::binary | std::ios::trunc) ;
+    if (!fichier) throw std::runtime_error("johnsonVersFichier: impossible de créer " + chemin) ;
+    fichier.write(reinterpret_cast<const char*>(&n), sizeof(n)) ;
+
+    std::mutex verrou ;
+    dijkstraToutesSources(repondere, potentiels, reservoir, [&](size_t source, const ResultatsDijkstraGenerique<P>& ligne) {
+        std::lock_guard<std::mutex> garde(verrou) ;
+        fichier.seekp(static_cast<std::streamoff>(sizeof(n) + source * n * sizeof(P))) ;
+        fichier.write(reinterpret_cast<const char*>(ligne.distances.data()), static_cast<std::streamsize>(n * sizeof(P))) ;
+    }) ;
+
+    if (!fichier.flush()) throw std::runtime_error("johnsonVersFichier: erreur d'écriture dans " + chemin) ;
+}
+
+namespace {
+
+    /**
+     * Ordre total sur les arêtes non orientées: par poids, puis par extrémités.  Borůvka en a besoin pour qu'en cas
+     * d'égalité de poids, toutes les composantes s'entendent sur la même arête et ne forment pas de cycle.
+     */
+    template <typename P>
+    bool areteInferieure(const AreteNonOrientee<P>& a, const AreteNonOrientee<P>& b) {
+        if (a.poids != b.poids) return a.poids < b.poids ;
+        if (a.u != b.u) return a.u < b.u ;
+        return a.v < b.v ;
+    }
+
+    /**
+     * Construit l'arête non orientée correspondant à un arc, extrémités en ordre croissant.
+     */
+    template <typename P>
+    AreteNonOrientee<P> areteDeArc(size_t depart, size_t destination, P poids) {
+        return depart < destination ? AreteNonOrientee<P> {depart, destination, poids}
+                                    : AreteNonOrientee<P> {destination, depart, poids} ;
+    }
+
+    /**
+     * Ajoute une arête à une forêt couvrante en tenant le poids total à jour.
+     */
+    template <typename P>
+    void ajouterArete(ForetCouvrante<P>& foret, const AreteNonOrientee<P>& arete) {
+        foret.aretes.push_back(arete) ;
+        foret.poidsTotal += arete.poids ;
+    }
+
+}
+
+/**
+ * Algorithme de Prim: fait croître l'arbre couvrant à partir d'un sommet, en y ajoutant toujours le sommet le plus
+ * proche, à l'aide d'une file prioritaire avec réduction de clé.  Le graphe est vu comme non orienté: les voisins d'un
+ * sommet sont pris dans le graphe et dans son inverse.  Lorsque la file ne contient plus que des sommets à distance
+ * infinie, une nouvelle composante commence: on obtient donc une forêt si le graphe n'est pas connexe.
+ * @param graphe Objet graphe à analyser
+ * @return La forêt couvrante minimale
+ */
+template <typename S, typename P>
+ForetCouvrante<P> prim(const GrapheGenerique<S, P>& graphe) {
+    ForetCouvrante<P> foret ;
+    const size_t n = graphe.taille() ;
+    if (n == 0) return foret ;
+
+    const GrapheGenerique<S, P> inverse = graphe.grapheInverse() ;
+    std::vector<size_t> parents(n, n) ;
+    std::vector<bool> dansArbre(n, false) ;
+    FilePrioritaire<P> file(std::vector<P>(n, TraitsPoids<P>::infini())) ;
+
+    while (!file.estVide()) {
+        auto courant = file.lireIndexMinimum() ;
+        P cle = file.lireMinimum() ;
+        file.extraireMinimum() ;
+        dansArbre.at(courant) = true ;
+        if (parents.at(courant) != n) ajouterArete(foret, areteDeArc(parents.at(courant), courant, cle)) ;
+
+        for (const auto* voisins: {&graphe.enumererVoisins(courant), &inverse.enumererVoisins(courant)})
+            for (const auto& arc: *voisins)
+                if (!dansArbre.at(arc.destination) && arc.poids < file.lireClePourIndex(arc.destination)) {
+                    file.reduireCle(arc.destination, arc.poids) ;
+                    parents.at(arc.destination) = courant ;
+                }
+    }
+    return foret ;
+}
+
+/**
+ * Algorithme de Kruskal: les arêtes sont triées par poids croissant et retenues si elles relient deux composantes
+ * encore distinctes, ce que l'on vérifie avec une structure union-find.
+ * @param graphe Objet graphe à analyser, vu comme non orienté
+ * @return La forêt couvrante minimale
+ */
+template <typename S, typename P>
+ForetCouvrante<P> kruskal(const GrapheGenerique<S, P>& graphe) {
+    ForetCouvrante<P> foret ;
+    std::vector<AreteNonOrientee<P>> aretes ;
+    for (size_t depart = 0; depart < graphe.taille(); ++depart)
+        for (const auto& arc: graphe.enumererVoisins(depart))
+            if (arc.destination != depart) aretes.push_back(areteDeArc(depart, arc.destination, arc.poids)) ;
+
+    std::sort(aretes.begin(), aretes.end(), areteInferieure<P>) ;
+
+    EnsemblesDisjoints composantes(graphe.taille()) ;
+    for (const auto& arete: aretes)
+        if (composantes.unir(arete.u, arete.v)) ajouterArete(foret, arete) ;
+
+    return foret ;
+}
+
+/**
+ * Algorithme de Borůvka, parallèle.  À chaque ronde, chaque sommet cherche sa plus légère arête sortant de sa
+ * composante; ce balayage de toutes les arêtes est réparti entre les fils.  Ensuite, chaque composante retient la plus
+ * légère des arêtes de ses sommets et les composantes sont fusionnées.  Le nombre de composantes diminue au moins de
+ * moitié à chaque ronde, d'où au plus log(n) rondes.
+ * @param graphe Objet graphe à analyser, vu comme non orienté
+ * @param reservoir Réservoir de fils
+ * @return La forêt couvrante minimale
+ */
+template <typename S, typename P>
+ForetCouvrante<P> boruvka(const GrapheGenerique<S, P>& graphe, ReservoirFils& reservoir) {
+    ForetCouvrante<P> foret ;
+    const size_t n = graphe.taille() ;
+    const GrapheGenerique<S, P> inverse = graphe.grapheInverse() ;
+    const AreteNonOrientee<P> aucune {n, n, TraitsPoids<P>::infini()} ;
+
+    EnsemblesDisjoints composantes(n) ;
+    std::vector<size_t> etiquettes(n) ;
+    std::vector<AreteNonOrientee<P>> meilleuresSommets(n, aucune), meilleuresComposantes(n, aucune) ;
+
+    bool fusion = true ;
+    while (fusion) {
+        for (size_t sommet = 0; sommet < n; ++sommet) etiquettes[sommet] = composantes.trouver(sommet) ;
+
+        reservoir.repartir(n, [&](size_t debut, size_t fin, size_t) {
+            for (size_t sommet = debut; sommet < fin; ++sommet) {
+                AreteNonOrientee<P> meilleure = aucune ;
+                for (const auto* voisins: {&graphe.enumererVoisins(sommet), &inverse.enumererVoisins(sommet)})
+                    for (const auto& arc: *voisins) {
+                        if (etiquettes[arc.destination] == etiquettes[sommet]) continue ;
+                        auto arete = areteDeArc(sommet, arc.destination, arc.poids) ;
+                        if (areteInferieure(arete, meilleure)) meilleure = arete ;
+                    }
+                meilleuresSommets[sommet] = meilleure ;
+            }
+        }, 256) ;
+
+        for (size_t sommet = 0; sommet < n; ++sommet) {
+            auto& meilleure = meilleuresComposantes[etiquettes[sommet]] ;
+            if (meilleuresSommets[sommet].u != n && areteInferieure(meilleuresSommets[sommet], meilleure))
+                meilleure = meilleuresSommets[sommet] ;
+        }
+
+        fusion = false ;
+        for (size_t racine = 0; racine < n; ++racine) {
+            auto& meilleure = meilleuresComposantes[racine] ;
+            if (meilleure.u == n) continue ;
+            if (composantes.unir(meilleure.u, meilleure.v)) {
+                ajouterArete(foret, meilleure) ;
+                fusion = true ;
+            }
+            meilleure = aucune ;
+        }
+    }
+    return foret ;
+}
+
+namespace {
+
+    /**
+     * @struct ReseauResiduel Graphe résiduel utilisé par le flot maximal, rangé en tableaux contigus.  Les arcs résiduels
+     * du sommet u occupent les positions debuts[u] à debuts[u + 1] - 1: d'abord ses arcs sortants, de capacité égale au
+     * poids de l'arc, puis ses arcs entrants inversés, de capacité nulle au départ.  inverses[a] donne la position de
+     * l'arc résiduel opposé à a.
+     */
+    template <typename P>
+    struct ReseauResiduel {
+        std::vector<size_t> debuts ;
+        std::vector<size_t> destinations ;
+        std::vector<size_t> inverses ;
+        std::vector<P> capacites ;
+
+        template <typename S>
+        explicit ReseauResiduel(const GrapheGenerique<S, P>& graphe) : debuts(graphe.taille() + 1, 0) {
+            const size_t n = graphe.taille() ;
+            std::vector<size_t> entrants(n, 0) ;
+            for (size_t u = 0; u < n; ++u)
+                for (const auto& arc: graphe.enumererVoisins(u)) {
+                    if (arc.poids < P(0)) throw std::invalid_argument("flotMaximal: capacité négative") ;
+                    ++ entrants[arc.destination] ;
+                }
+            for (size_t u = 0; u < n; ++u) debuts[u + 1] = debuts[u] + graphe.ariteSortie(u) + entrants[u] ;
+
+            destinations.resize(debuts[n]) ;
+            inverses.resize(debuts[n]) ;
+            capacites.resize(debuts[n], P(0)) ;
+
+            std::vector<size_t> prochainEntrant(n) ;
+            for (size_t u = 0; u < n; ++u) prochainEntrant[u] = debuts[u] + graphe.ariteSortie(u) ;
+            for (size_t u = 0; u < n; ++u) {
+                size_t a = debuts[u] ;
+                for (const auto& arc: graphe.enumererVoisins(u)) {
+                    size_t b = prochainEntrant[arc.destination] ++ ;
+                    destinations[a] = arc.destination ;
+                    capacites[a] = arc.poids ;
+                    inverses[a] = b ;
+                    destinations[b] = u ;
+                    inverses[b] = a ;
+                    ++ a ;
+                }
+            }
+        }
+
+        size_t taille() const {return debuts.size() - 1 ; }
+    };
+
+    /**
+     * Étiquetage global: recalcule les hauteurs exactes, soit la distance de chaque sommet au puits dans le graphe
+     * résiduel, par un parcours en largeur à reculons à partir du puits.  Les sommets qui n'atteignent plus le puits
+     * reçoivent la hauteur n et sont ainsi retirés de la première phase.
+     * @return La liste des sommets atteints, dans l'ordre du parcours
+     */
+    template <typename P>
+    std::vector<size_t> etiquetageGlobal(const ReseauResiduel<P>& reseau, size_t source, size_t puits,
+                                         std::vector<size_t>& hauteurs, std::vector<size_t>& comptes) {
+        const size_t n = reseau.taille() ;
+        std::fill(hauteurs.begin(), hauteurs.end(), n) ;
+        std::fill(comptes.begin(), comptes.end(), 0) ;
+
+        std::vector<size_t> atteints {puits} ;
+        hauteurs[puits] = 0 ;
+        for (size_t i = 0; i < atteints.size(); ++i) {
+            size_t v = atteints[i] ;
+            for (size_t a = reseau.debuts[v]; a < reseau.debuts[v + 1]; ++a) {
+                size_t u = reseau.destinations[a] ;
+                if (hauteurs[u] == n && u != source && reseau.capacites[reseau.inverses[a]] > P(0)) {
+                    hauteurs[u] = hauteurs[v] + 1 ;
+                    atteints.push_back(u) ;
+                }
+            }
+        }
+        hauteurs[source] = n ;
+        for (auto h: hauteurs) ++ comptes[h] ;
+        return atteints ;
+    }
+
+}
+
+/**
+ * Flot maximal par poussage-réétiquetage (push-relabel), les poids des arcs servant de capacités.  Les sommets actifs
+ * sont traités en file (FIFO).  Deux heuristiques accélèrent le calcul: l'étiquetage global, qui recalcule
+ * périodiquement les hauteurs exactes par un parcours en largeur à partir du puits, et l'heuristique de l'écart (gap):
+ * lorsque plus aucun sommet n'a une hauteur h, tous les sommets plus hauts ne peuvent plus atteindre le puits.
+ *
+ * Seule la première phase de l'algorithme (le pré-flot maximal) est calculée: elle suffit pour obtenir la valeur du
+ * flot et la coupe minimale, formée des sommets qui ne peuvent plus atteindre le puits dans le graphe résiduel.
+ *
+ * @param graphe Objet graphe dont les poids sont les capacités
+ * @param source Numéro du sommet source
+ * @param puits Numéro du sommet puits
+ * @return La valeur du flot maximal et le côté source de la coupe minimale
+ * @except std::invalid_argument si la source ou le puits est invalide, s'ils sont identiques, ou si une capacité est
+ * négative
+ */
+template <typename S, typename P>
+ResultatsFlot<P> flotMaximal(const GrapheGenerique<S, P>& graphe, size_t source, size_t puits) {
+    if (!graphe.sommetExiste(source) || !graphe.sommetExiste(puits) || source == puits)
+        throw std::invalid_argument("flotMaximal: source ou puits invalide") ;
+
+    ReseauResiduel<P> reseau(graphe) ;
+    const size_t n = graphe.taille() ;
+    std::vector<P> exces(n, P(0)) ;
+    std::vector<size_t> hauteurs(n), comptes(2 * n + 1), courants(reseau.debuts.begin(), reseau.debuts.end() - 1) ;
+    std::queue<size_t> actifs ;
+
+    for (size_t a = reseau.debuts[source]; a < reseau.debuts[source + 1]; ++a) {
+        P capacite = reseau.capacites[a] ;
+        if (capacite == P(0)) continue ;
+        size_t v = reseau.destinations[a] ;
+        reseau.capacites[a] = P(0) ;
+        reseau.capacites[reseau.inverses[a]] += capacite ;
+        exces[v] += capacite ;
+    }
+    etiquetageGlobal(reseau, source, puits, hauteurs, comptes) ;
+    for (size_t v = 0; v < n; ++v)
+        if (v != source && v != puits && exces[v] > P(0) && hauteurs[v] < n) actifs.push(v) ;
+
+    size_t reetiquetages = 0 ;
+    while (!actifs.empty()) {
+        size_t u = actifs.front() ;
+        actifs.pop() ;
+
+        while (exces[u] > P(0) && hauteurs[u] < n) {
+            if (courants[u] == reseau.debuts[u + 1]) {
+                size_t ancienne = hauteurs[u] ;
+                size_t nouvelle = 2 * n ;
+                for (size_t a = reseau.debuts[u]; a < reseau.debuts[u + 1]; ++a)
+                    if (reseau.capacites[a] > P(0)) nouvelle = std::min(nouvelle, hauteurs[reseau.destinations[a]] + 1) ;
+                -- comptes[ancienne] ;
+                hauteurs[u] = std::min(nouvelle, n) ;
+                ++ comptes[hauteurs[u]] ;
+                courants[u] = reseau.debuts[u] ;
+
+                if (comptes[ancienne] == 0 && ancienne < n)
+                    for (size_t v = 0; v < n; ++v)
+                        if (hauteurs[v] > ancienne && hauteurs[v] < n) {
+                            -- comptes[hauteurs[v]] ;
+                            hauteurs[v] = n ;
+                            ++ comptes[n] ;
+                        }
+
+                if (++ reetiquetages % n == 0) {
+                    etiquetageGlobal(reseau, source, puits, hauteurs, comptes) ;
+                    for (size_t v = 0; v < n; ++v) courants[v] = reseau.debuts[v] ;
+                }
+                continue ;
+            }
+
+            size_t a = courants[u] ;
+            size_t v = reseau.destinations[a] ;
+            if (reseau.capacites[a] > P(0) && hauteurs[u] == hauteurs[v] + 1) {
+                P pousse = std::min(exces[u], reseau.capacites[a]) ;
+                bool etaitInactif = exces[v] == P(0) ;
+                reseau.capacites[a] -= pousse ;
+                reseau.capacites[reseau.inverses[a]] += pousse ;
+                exces[u] -= pousse ;
+                exces[v] += pousse ;
+                if (etaitInactif && v != source && v != puits) actifs.push(v) ;
+            }
+            else ++ courants[u] ;
+        }
+    }
+
+    ResultatsFlot<P> resultats {exces[puits], std::vector<bool>(n, true)} ;
+    for (auto v: etiquetageGlobal(reseau, source, puits, hauteurs, comptes)) resultats.coteSource[v] = false ;
+    return resultats ;
+}
+
+namespace {
+
+    /**
+     * @class ProgrammePageRank Programme de sommets (voir ProgrammeSommets.h) calculant le PageRank.  Le score d'un
+     * sommet v est (1 - a) p(v) + a (somme des score(u) / aritéSortie(u) sur ses prédécesseurs u + m p(v)), où a est
+     * l'amortissement, p la personnalisation et m la masse des sommets sans arc sortant, redistribuée selon p.
+     */
+    template <typename G>
+    class ProgrammePageRank {
+    public:
+        using Valeur = double ;
+
+        ProgrammePageRank(const G& graphe, const ParametresPageRank& parametres)
+            : amortissement(parametres.amortissement), tolerance(parametres.tolerance),
+              personnalisation(parametres.personnalisation), inversesArites(graphe.taille()), orphelins(), masse(-1) {
+            const size_t n = graphe.taille() ;
+            if (amortissement < 0 || amortissement >= 1) throw std::invalid_argument("pageRank: amortissement invalide") ;
+            if (personnalisation.empty()) personnalisation.assign(n, n ? 1.0 / static_cast<double>(n) : 0.0) ;
+            if (personnalisation.size() != n) throw std::invalid_argument("pageRank: personnalisation de taille invalide") ;
+
+            double total = 0 ;
+            for (auto valeur: personnalisation) {
+                if (valeur < 0) throw std::invalid_argument("pageRank: personnalisation négative") ;
+                total += valeur ;
+            }
+            if (n > 0 && total <= 0) throw std::invalid_argument("pageRank: personnalisation nulle") ;
+            for (auto& valeur: personnalisation) valeur /= total ;
+
+            for (size_t sommet = 0; sommet < n; ++sommet) {
+                size_t arite = graphe.ariteSortie(sommet) ;
+                if (arite == 0) orphelins.push_back(sommet) ;
+                else inversesArites[sommet] = 1.0 / static_cast<double>(arite) ;
+            }
+        }
+
+        double initiale(size_t sommet) const {return personnalisation[sommet] ; }
+
+        bool preparer(const std::vector<double>& valeurs) {
+            double nouvelle = 0 ;
+            for (auto sommet: orphelins) nouvelle += valeurs[sommet] ;
+            bool changee = amortissement * std::abs(nouvelle - masse) > tolerance ;
+            masse = nouvelle ;
+            return changee ;
+        }
+
+        template <typename Liste>
+        double calculer(size_t sommet, const Liste& entrants, const std::vector<double>& valeurs) const {
+            double somme = 0 ;
+            for (const auto& arc: entrants) somme += valeurs[arc.destination] * inversesArites[arc.destination] ;
+            return (1 - amortissement) * personnalisation[sommet] + amortissement * (somme + masse * personnalisation[sommet]) ;
+        }
+
+        bool change(double ancienne, double nouvelle) const {return std::abs(nouvelle - ancienne) > tolerance ; }
+
+    private:
+        double amortissement ;
+        double tolerance ;
+        std::vector<double> personnalisation ;
+        std::vector<double> inversesArites ;
+        std::vector<size_t> orphelins ;
+        double masse ;
+    };
+
+}
+
+/**
+ * Calcule le PageRank de chaque sommet, par itérations parallèles en mode « pull » sur le graphe inverse (voir
+ * executerProgrammeSommets).  Les poids des arcs sont ignorés.  Les sommets dont le score a convergé cessent d'être
+ * recalculés tant que leurs prédécesseurs ne changent plus.
+ * @param graphe Objet graphe à analyser
+ * @param parametres Amortissement, tolérance, limite d'itérations et personnalisation
+ * @param reservoir Réservoir de fils
+ * @return Les scores, dont la somme vaut 1, le nombre d'itérations et l'état de la convergence
+ * @except std::invalid_argument si les paramètres sont invalides
+ */
+template <typename S, typename P>
+EtatIteratif<double> pageRank(const GrapheGenerique<S, P>& graphe, const ParametresPageRank& parametres,
+                              ReservoirFils& reservoir) {
+    ProgrammePageRank<GrapheGenerique<S, P>> programme(graphe, parametres) ;
+    return executerProgrammeSommets(graphe, programme, parametres.iterationsMax, reservoir) ;
+}
+
+/**
+ * PageRank d'un graphe compressé, calculé comme pour un GrapheGenerique.
+ * @param graphe Le graphe compressé à analyser
+ * @param parametres Amortissement, tolérance, limite d'itérations et personnalisation
+ * @param reservoir Réservoir de fils
+ * @return Les scores, le nombre d'itérations et l'état de la convergence
+ * @except std::invalid_argument si les paramètres sont invalides
+ */
+template <typename P>
+EtatIteratif<double> pageRank(const GrapheCompresse<P>& graphe, const ParametresPageRank& parametres,
+                              ReservoirFils& reservoir) {
+    ProgrammePageRank<GrapheCompresse<P>> programme(graphe, parametres) ;
+    return executerProgrammeSommets(graphe, programme, parametres.iterationsMax, reservoir) ;
+}
+
+namespace {
+
+    /**
+     * @struct EspaceBrandes Espace de travail d'un fil pour l'algorithme de Brandes, réutilisé d'une source à l'autre.
+     * Seules les entrées des sommets atteints (listés dans ordre) sont remises à zéro entre deux sources.
+     *
+     * distances, sigma: distance et nombre de plus courts chemins depuis la source.
+     * delta: dépendance de la source envers chaque sommet.
+     * ordre: sommets atteints, par distance non décroissante.
+     * predecesseurs: pour chaque sommet, ses prédécesseurs sur les plus courts chemins.
+     * cumuls: intermédiarité accumulée par ce fil.
+     * tas: tas binaire paresseux du parcours pondéré, comme dans dijkstraBorne; il est vide entre deux sources.
+     */
+    struct EspaceBrandes {
+        std::vector<double> distances ;
+        std::vector<double> sigma ;
+        std::vector<double> delta ;
+        std::vector<size_t> ordre ;
+        std::vector<std::vector<size_t>> predecesseurs ;
+        std::vector<double> cumuls ;
+        std::vector<std::pair<double, size_t>> tas ;
+
+        explicit EspaceBrandes(size_t n) : distances(n, std::numeric_limits<double>::infinity()), sigma(n, 0),
+                                           delta(n, 0), ordre(), predecesseurs(n), cumuls(n, 0), tas() {}
+    };
+
+    /**
+     * Première phase de Brandes, non pondérée: parcours en largeur à partir de la source, comme exploreBFS, en comptant
+     * les plus courts chemins.
+     */
+    template <typename S, typename P>
+    void parcoursBrandesLargeur(const GrapheGenerique<S, P>& graphe, size_t source, EspaceBrandes& espace) {
+        espace.distances[source] = 0 ;
+        espace.sigma[source] = 1 ;
+        espace.ordre.push_back(source) ;
+
+        for (size_t i = 0; i < espace.ordre.size(); ++i) {
+            size_t courant = espace.ordre[i] ;
+            for (const auto& arc: graphe.enumererVoisins(courant)) {
+                size_t voisin = arc.destination ;
+                if (espace.distances[voisin] == std::numeric_limits<double>::infinity()) {
+                    espace.distances[voisin] = espace.distances[courant] + 1 ;
+                    espace.ordre.push_back(voisin) ;
+                }
+                if (espace.distances[voisin] == espace.distances[courant] + 1) {
+                    espace.sigma[voisin] += espace.sigma[courant] ;
+                    espace.predecesseurs[voisin].push_back(courant) ;
+                }
+            }
+        }
+    }
+
+    /**
+     * Première phase de Brandes, pondérée: Dijkstra à partir de la source, en comptant les plus courts chemins.  Le tas
+     * paresseux de l'espace ne contient que des sommets atteints: une source ne coûte que son ensemble atteint.
+     */
+    template <typename S, typename P>
+    void parcoursBrandesPondere(const GrapheGenerique<S, P>& graphe, size_t source, EspaceBrandes& espace) {
+        using Entree = std::pair<double, size_t> ;
+        const auto plusGrand = std::greater<Entree>() ;
+        espace.tas.emplace_back(0.0, source) ;
+        espace.distances[source] = 0 ;
+        espace.sigma[source] = 1 ;
+
+        while (!espace.tas.empty()) {
+            std::pop_heap(espace.tas.begin(), espace.tas.end(), plusGrand) ;
+            const Entree entree = espace.tas.back() ;
+            espace.tas.pop_back() ;
+            const size_t courant = entree.second ;
+            if (entree.first > espace.distances[courant]) continue ;     // Entrée périmée
+
+            espace.ordre.push_back(courant) ;
+            for (const auto& arc: graphe.enumererVoisins(courant)) {
+                size_t voisin = arc.destination ;
+                double distance = espace.distances[courant] + static_cast<double>(arc.poids) ;
+                if (distance < espace.distances[voisin]) {
+                    espace.distances[voisin] = distance ;
+                    espace.tas.emplace_back(distance, voisin) ;
+                    std::push_heap(espace.tas.begin(), espace.tas.end(), plusGrand) ;
+                    espace.sigma[voisin] = espace.sigma[courant] ;
+                    espace.predecesseurs[voisin].assign(1, courant) ;
+                }
+                else if (distance == espace.distances[voisin]) {
+                    espace.sigma[voisin] += espace.sigma[courant] ;
+                    espace.predecesseurs[voisin].push_back(courant) ;
+                }
+            }
+        }
+    }
+
+    template <typename S>
+    void parcoursBrandesPondere(const GrapheGenerique<S, SansPoids>& graphe, size_t source, EspaceBrandes& espace) {
+        parcoursBrandesLargeur(graphe, source, espace) ;
+    }
+
+    /**
+     * Seconde phase de Brandes: remonte les sommets par distance décroissante pour accumuler les dépendances, puis
+     * remet l'espace de travail à zéro pour la prochaine source.
+     */
+    void accumulerBrandes(size_t source, double echelle, EspaceBrandes& espace) {
+        for (auto it = espace.ordre.rbegin(); it != espace.ordre.rend(); ++it) {
+            size_t sommet = *it ;
+            for (auto predecesseur: espace.predecesseurs[sommet])
+                espace.delta[predecesseur] += espace.sigma[predecesseur] / espace.sigma[sommet] * (1 + espace.delta[sommet]) ;
+            if (sommet != source) espace.cumuls[sommet] += echelle * espace.delta[sommet] ;
+        }
+
+        for (auto sommet: espace.ordre) {
+            espace.distances[sommet] = std::numeric_limits<double>::infinity() ;
+            espace.sigma[sommet] = 0 ;
+            espace.delta[sommet] = 0 ;
+            espace.predecesseurs[sommet].clear() ;
+        }
+        espace.ordre.clear() ;
+    }
+
+}
+
+/**
+ * Calcule l'intermédiarité (betweenness centrality) de chaque sommet par l'algorithme de Brandes: pour chaque source,
+ * un parcours compte les plus courts chemins, puis les dépendances sont accumulées à rebours.  Les sources sont
+ * réparties entre les fils du réservoir, chaque fil accumulant dans son propre espace de travail; les cumuls des fils
+ * sont additionnés à la fin.
+ *
+ * En mode approximatif (parametres.erreur > 0), k sources sont tirées au hasard, sans remise, avec
+ * k = ln(2n / probabiliteEchec) / (2 erreur²) selon la borne de Hoeffding, et les résultats sont multipliés par n / k.
+ * Si k >= n, le calcul exact est effectué.
+ *
+ * @param graphe Objet graphe à analyser, orienté
+ * @param parametres Mode pondéré ou non, et paramètres de l'échantillonnage
+ * @param reservoir Réservoir de fils
+ * @return L'intermédiarité de chaque sommet: le nombre, éventuellement estimé, de paires (s, t) dont les plus courts
+ * chemins passent par le sommet, chaque paire étant pondérée par la fraction de ses plus courts chemins concernés
+ * @pre En mode pondéré, les poids doivent être strictement positifs
+ * @except std::invalid_argument si les paramètres d'échantillonnage sont invalides
+ */
+template <typename S, typename P>
+std::vector<double> intermediarite(const GrapheGenerique<S, P>& graphe, const ParametresIntermediarite& parametres,
+                                   ReservoirFils& reservoir) {
+    const size_t n = graphe.taille() ;
+    if (parametres.erreur < 0 || parametres.probabiliteEchec <= 0 || parametres.probabiliteEchec >= 1)
+        throw std::invalid_argument("intermediarite: paramètres d'échantillonnage invalides") ;
+
+    std::vector<size_t> sources(n) ;
+    std::iota(sources.begin(), sources.end(), 0) ;
+    double echelle = 1 ;
+    if (parametres.erreur > 0 && n > 0) {
+        double k = std::ceil(std::log(2.0 * static_cast<double>(n) / parametres.probabiliteEchec)
+                             / (2 * parametres.erreur * parametres.erreur)) ;
+        if (k < static_cast<double>(n)) {
+            std::mt19937 generateur(parametres.graine) ;
+            std::shuffle(sources.begin(), sources.end(), generateur) ;
+            sources.resize(static_cast<size_t>(k)) ;
+            echelle = static_cast<double>(n) / k ;
+        }
+    }
+
+    std::vector<std::unique_ptr<EspaceBrandes>> espaces(reservoir.taille()) ;
+    reservoir.repartir(sources.size(), [&](size_t debut, size_t fin, size_t fil) {
+        if (!espaces[fil]) espaces[fil].reset(new EspaceBrandes(n)) ;
+        auto& espace = *espaces[fil] ;
+        for (size_t i = debut; i < fin; ++i) {
+            if (parametres.ponderee) parcoursBrandesPondere(graphe, sources[i], espace) ;
+            else parcoursBrandesLargeur(graphe, sources[i], espace) ;
+            accumulerBrandes(sources[i], echelle, espace) ;
+        }
+    }) ;
+
+    std::vector<double> resultat(n, 0) ;
+    for (const auto& espace: espaces)
+        if (espace) for (size_t sommet = 0; sommet < n; ++sommet) resultat[sommet] += espace->cumuls[sommet] ;
+    return resultat ;
+}
+
+/**
+ * Énumère les composantes faiblement connexes d'un graphe, c'est-à-dire les composantes connexes de sa vue non
+ * orientée.  Chaque arc est soumis à une structure union-find sans verrou (EnsemblesDisjointsConcurrents), les sommets
+ * étant répartis entre les fils du réservoir; une seconde passe parallèle lit ensuite le représentant de chaque sommet.
+ * Pour suivre les composantes d'un graphe en construction, voir plutôt ComposantesIncrementales.
+ * @param graphe Objet graphe à analyser
+ * @param reservoir Réservoir de fils
+ * @return Pour chaque sommet, l'identifiant de sa composante: le plus petit numéro de sommet de cette composante
+ */
+template <typename S, typename P>
+std::vector<size_t> composantesFaiblementConnexes(const GrapheGenerique<S, P>& graphe, ReservoirFils& reservoir) {
+    const size_t n = graphe.taille() ;
+    EnsemblesDisjointsConcurrents ensembles(n) ;
+
+    reservoir.repartir(n, [&](size_t debut, size_t fin, size_t) {
+        for (size_t depart = debut; depart < fin; ++depart)
+            for (const auto& arc: graphe.enumererVoisins(depart)) ensembles.unir(depart, arc.destination) ;
+    }, 1024) ;
+
+    std::vector<size_t> etiquettes(n) ;
+    reservoir.repartir(n, [&](size_t debut, size_t fin, size_t) {
+        for (size_t sommet = debut; sommet < fin; ++sommet) etiquettes[sommet] = ensembles.trouver(sommet) ;
+    }, 1024) ;
+    return etiquettes ;
+}
+
+/**
+ * Énumère les sommets situés à au plus k sauts d'un départ.  C'est un parcours en largeur, comme exploreBFS, qui cesse
+ * d'étendre la frontière une fois la limite atteinte.  La liste des résultats sert elle-même de file d'attente, et
+ * l'espace de travail évite toute initialisation en O(n): le coût ne dépend que de la taille du voisinage.
+ * @param graphe Objet graphe à explorer
+ * @param depart Numéro du sommet de départ
+ * @param sautsMax Nombre maximal d'arcs entre le départ et un sommet retenu
+ * @param espace Espace de travail réutilisable; reçoit aussi les résultats
+ * @return Les sommets atteints, par nombre de sauts croissant, le départ en premier.  La référence reste valide jusqu'à
+ * la prochaine requête faite avec le même espace.
+ * @except std::invalid_argument si le départ n'est pas dans le graphe
+ */
+template <typename S, typename P>
+const std::vector<SommetAtteint<size_t>>& voisinageSauts(const GrapheGenerique<S, P>& graphe, size_t depart,
+                                                         size_t sautsMax, EspaceVoisinage<size_t>& espace) {
+    if (!graphe.sommetExiste(depart)) throw std::invalid_argument("voisinageSauts: sommet invalide") ;
+
+    espace.preparer(graphe.taille()) ;
+    espace.atteints[depart] = espace.generation ;
+    espace.resultats.push_back({depart, 0, depart}) ;
+
+    for (size_t i = 0; i < espace.resultats.size(); ++i) {
+        const auto courant = espace.resultats[i] ;
+        if (courant.distance == sautsMax) break ;
+        for (const auto& arc: graphe.enumererVoisins(courant.sommet)) {
+            if (espace.atteints[arc.destination] == espace.generation) continue ;
+            espace.atteints[arc.destination] = espace.generation ;
+            espace.resultats.push_back({arc.destination, courant.distance + 1, courant.sommet}) ;
+        }
+    }
+    return espace.resultats ;
+}
+
+namespace {
+
+    /**
+     * Dijkstra à tas binaire paresseux sur un espace de voisinage, commun à voisinageRayon et cheminPlusCourt.  Les
+     * sommets fixés sont ajoutés à espace.resultats.  S'arrête lorsque le tas est vide, lorsque le plus proche sommet
+     * restant est hors du rayon, ou dès que l'arrivée est fixée.
+     */
+    template <typename S, typename P>
+    void dijkstraBorne(const GrapheGenerique<S, P>& graphe, size_t depart, P rayon, size_t arrivee,
+                       EspaceVoisinage<P>& espace) {
+        using Entree = std::pair<P, size_t> ;
+        const auto plusGrand = std::greater<Entree>() ;
+        espace.preparer(graphe.taille()) ;
+        espace.atteints[depart] = espace.generation ;
+        espace.distances[depart] = 0 ;
+        espace.predecesseurs[depart] = depart ;
+        espace.tas.emplace_back(P(0), depart) ;
+
+        while (!espace.tas.empty()) {
+            std::pop_heap(espace.tas.begin(), espace.tas.end(), plusGrand) ;
+            const Entree entree = espace.tas.back() ;
+            espace.tas.pop_back() ;
+            const size_t courant = entree.second ;
+            if (espace.fixes[courant] == espace.generation) continue ;
+
+            espace.fixes[courant] = espace.generation ;
+            espace.resultats.push_back({courant, entree.first, espace.predecesseurs[courant]}) ;
+            if (courant == arrivee) return ;
+
+            for (const auto& arc: graphe.enumererVoisins(courant)) {
+                P distance = entree.first + arc.poids ;
+                if (distance > rayon) continue ;
+                if (espace.atteints[arc.destination] == espace.generation && !(distance < espace.distances[arc.destination]))
+                    continue ;
+                espace.atteints[arc.destination] = espace.generation ;
+                espace.distances[arc.destination] = distance ;
+                espace.predecesseurs[arc.destination] = courant ;
+                espace.tas.emplace_back(distance, arc.destination) ;
+                std::push_heap(espace.tas.begin(), espace.tas.end(), plusGrand) ;
+            }
+        }
+    }
+
+}
+
+/**
+ * Énumère les sommets situés à une distance pondérée d'au plus un rayon donné.  C'est l'algorithme de Dijkstra, mais
+ * avec un tas binaire paresseux plutôt qu'une FilePrioritaire, dont la construction coûterait O(n): seuls les sommets
+ * à l'intérieur du rayon entrent dans le tas, et l'exploration s'arrête dès que le plus proche sommet restant est hors
+ * du rayon.
+ * @param graphe Objet graphe à explorer
+ * @param depart Numéro du sommet de départ
+ * @param rayon Distance maximale d'un sommet retenu
+ * @param espace Espace de travail réutilisable; reçoit aussi les résultats
+ * @return Les sommets atteints, par distance croissante, le départ en premier.  La référence reste valide jusqu'à la
+ * prochaine requête faite avec le même espace.
+ * @pre Les pondérations doivent être positives ou nulles
+ * @except std::invalid_argument si le départ n'est pas dans le graphe
+ */
+template <typename S, typename P>
+const std::vector<SommetAtteint<P>>& voisinageRayon(const GrapheGenerique<S, P>& graphe, size_t depart, P rayon,
+                                                    EspaceVoisinage<P>& espace) {
+    if (!graphe.sommetExiste(depart)) throw std::invalid_argument("voisinageRayon: sommet invalide") ;
+
+    dijkstraBorne(graphe, depart, rayon, graphe.taille(), espace) ;
+    return espace.resultats ;
+}
+
+/**
+ * Reconstruit un plus court chemin à partir de l'arbre des prédécesseurs calculé par dijkstra, dijkstraFilePrioritaire
+ * ou bellmanFord, en O(longueur du chemin).
+ * @param resultats Les résultats d'un calcul de plus courts chemins à source unique
+ * @param destination Numéro du sommet d'arrivée
+ * @param chemin Reçoit les sommets du chemin, de la source à la destination; vide si la destination est inaccessible.
+ * Sa capacité est réutilisée d'un appel à l'autre.
+ * @return La longueur du chemin, ou TraitsPoids<P>::infini() si la destination est inaccessible
+ * @except std::invalid_argument si la destination n'est pas un sommet du graphe
+ */
+template <typename P>
+P extraireChemin(const ResultatsDijkstraGenerique<P>& resultats, size_t destination, std::vector<size_t>& chemin) {
+    const size_t n = resultats.predecesseurs.size() ;
+    if (destination >= n) throw std::invalid_argument("extraireChemin: destination invalide") ;
+
+    chemin.clear() ;
+    if (resultats.distances[destination] == TraitsPoids<P>::infini()) return TraitsPoids<P>::infini() ;
+    for (size_t sommet = destination; sommet != n; sommet = resultats.predecesseurs[sommet]) chemin.push_back(sommet) ;
+    std::reverse(chemin.begin(), chemin.end()) ;
+    return resultats.distances[destination] ;
+}
+
+/**
+ * Plus court chemin entre deux sommets.  Même recherche que voisinageRayon, sans rayon, mais interrompue dès que
+ * l'arrivée est atteinte: seuls les sommets plus proches que l'arrivée sont visités, et rien n'est alloué en O(n)
+ * d'une requête à l'autre.  C'est la requête point à point à privilégier lorsqu'on n'a pas besoin de tout l'arbre des
+ * plus courts chemins.
+ * @param graphe Objet graphe à explorer
+ * @param depart Numéro du sommet de départ
+ * @param arrivee Numéro du sommet d'arrivée
+ * @param espace Espace de travail réutilisable
+ * @param chemin Reçoit les sommets du chemin, du départ à l'arrivée; vide si l'arrivée est inaccessible.  Sa capacité
+ * est réutilisée d'un appel à l'autre.
+ * @return La longueur du chemin, ou TraitsPoids<P>::infini() si l'arrivée est inaccessible
+ * @pre Les pondérations doivent être positives ou nulles
+ * @except std::invalid_argument si un des sommets n'est pas dans le graphe
+ */
+template <typename S, typename P>
+P cheminPlusCourt(const GrapheGenerique<S, P>& graphe, size_t depart, size_t arrivee, EspaceVoisinage<P>& espace,
+                  std::vector<size_t>& chemin) {
+    if (!graphe.sommetExiste(depart)) throw std::invalid_argument("cheminPlusCourt: départ invalide") ;
+    if (!graphe.sommetExiste(arrivee)) throw std::invalid_argument("cheminPlusCourt: arrivée invalide") ;
+
+    chemin.clear() ;
+    dijkstraBorne(graphe, depart, TraitsPoids<P>::infini(), arrivee, espace) ;
+    if (espace.fixes[arrivee] != espace.generation) return TraitsPoids<P>::infini() ;
+
+    for (size_t sommet = arrivee; sommet != depart; sommet = espace.predecesseurs[sommet]) chemin.push_back(sommet) ;
+    chemin.push_back(depart) ;
+    std::reverse(chemin.begin(), chemin.end()) ;
+    return espace.distances[arrivee] ;
+}
+
+/**
+ * Plus court chemin entre deux sommets, pour qui n'a pas d'espace de travail à fournir.  Un espace propre au fil
+ * appelant est conservé d'un appel à l'autre: seul le chemin est alloué, jamais de vecteur de n distances.
+ * @param graphe Objet graphe à explorer
+ * @param depart Numéro du sommet de départ
+ * @param arrivee Numéro du sommet d'arrivée
+ * @return La longueur du chemin et ses sommets
+ * @pre Les pondérations doivent être positives ou nulles
+ * @except std::invalid_argument si un des sommets n'est pas dans le graphe
+ */
+template <typename S, typename P>
+CheminTrouve<P> cheminPlusCourt(const GrapheGenerique<S, P>& graphe, size_t depart, size_t arrivee) {
+    thread_local EspaceVoisinage<P> espace ;
+    CheminTrouve<P> resultat {P(), {}} ;
+    resultat.longueur = cheminPlusCourt(graphe, depart, arrivee, espace, resultat.sommets) ;
+    return resultat ;
+}
+
+/**
+ * Reconstruit un chemin à partir des prédécesseurs donnés par exploreBFS, en O(longueur du chemin).
+ * @param predecesseurs Le vecteur retourné par exploreBFS
+ * @param depart Le sommet de départ du parcours
+ * @param destination Numéro du sommet d'arrivée
+ * @param chemin Reçoit les sommets du chemin, du départ à la destination; vide si la destination est inaccessible.
+ * Sa capacité est réutilisée d'un appel à l'autre.
+ * @return true si la destination est accessible
+ * @except std::invalid_argument si le départ ou la destination n'est pas un sommet du graphe
+ */
+bool extraireCheminBFS(const std::vector<size_t>& predecesseurs, size_t depart, size_t destination,
+                       std::vector<size_t>& chemin) {
+    const size_t n = predecesseurs.size() ;
+    if (depart >= n || destination >= n) throw std::invalid_argument("extraireCheminBFS: sommet invalide") ;
+
+    chemin.clear() ;
+    if (destination != depart && predecesseurs[destination] == n) return false ;
+    for (size_t sommet = destination; sommet != depart; sommet = predecesseurs[sommet]) chemin.push_back(sommet) ;
+    chemin.push_back(depart) ;
+    std::reverse(chemin.begin(), chemin.end()) ;
+    return true ;
+}
+
+/**
+ * Sérialise un arbre de plus courts chemins dans un format compact, pour le transmettre à un autre processus.  Seuls
+ * les sommets atteints sont écrits, en ordre croissant: l'écart au sommet précédent et l'écart entre le prédécesseur
+ * et le sommet, tous deux en varint (le second en zigzag, pour les écarts négatifs), puis la distance dans la
+ * représentation native de P.  L'en-tête donne le nombre de sommets, la source et le nombre de sommets atteints.
+ * @param resultats Les résultats d'un calcul de plus courts chemins à source unique
+ * @param octets Reçoit le format sérialisé; sa capacité est réutilisée d'un appel à l'autre
+ * @except std::invalid_argument si les résultats n'ont pas de source
+ */
+template <typename P>
+void serialiserArbre(const ResultatsDijkstraGenerique<P>& resultats, std::vector<uint8_t>& octets) {
+    const size_t n = resultats.predecesseurs.size() ;
+    size_t source = n, atteints = 0 ;
+    for (size_t sommet = 0; sommet < n; ++sommet) {
+        if (resultats.distances[sommet] == TraitsPoids<P>::infini()) continue ;
+        if (resultats.predecesseurs[sommet] == n) source = sommet ;
+        else ++ atteints ;
+    }
+    if (source == n) throw std::invalid_argument("serialiserArbre: aucune source") ;
+
+    octets.clear() ;
+    ecrireVarint(octets, n) ;
+    ecrireVarint(octets, source) ;
+    ecrireVarint(octets, atteints) ;
+    size_t suivant = 0 ;
+    for (size_t sommet = 0; sommet < n; ++sommet) {
+        if (sommet == source || resultats.distances[sommet] == TraitsPoids<P>::infini()) continue ;
+        auto ecart = static_cast<int64_t>(resultats.predecesseurs[sommet]) - static_cast<int64_t>(sommet) ;
+        ecrireVarint(octets, sommet - suivant) ;
+        ecrireVarint(octets, (static_cast<uint64_t>(ecart) << 1) ^ static_cast<uint64_t>(ecart >> 63)) ;
+        const uint8_t* brut = reinterpret_cast<const uint8_t*>(&resultats.distances[sommet]) ;
+        octets.insert(octets.end(), brut, brut + sizeof(P)) ;
+        suivant = sommet + 1 ;
+    }
+}
+
+/**
+ * Relit un arbre écrit par serialiserArbre.  Les données sont validées: elles peuvent venir d'une source non fiable.
+ * Le nombre de sommets annoncé par l'en-tête est borné par l'appelant avant toute allocation, puisque les sommets non
+ * atteints n'occupent aucun octet et qu'un en-tête de quelques octets pourrait sinon exiger des gigaoctets.
+ * @param octets Le format sérialisé
+ * @param sommetsMax Nombre maximal de sommets accepté, normalement la taille du graphe attendu
+ * @return Les résultats, identiques à ceux qui ont été sérialisés
+ * @except std::invalid_argument si les données sont tronquées ou incohérentes, ou annoncent plus de sommetsMax sommets
+ */
+template <typename P>
+ResultatsDijkstraGenerique<P> deserialiserArbre(const std::vector<uint8_t>& octets, size_t sommetsMax) {
+    const uint8_t* curseur = octets.data() ;
+    const uint8_t* fin = curseur + octets.size() ;
+    const size_t n = lireVarintBorne(curseur, fin) ;
+    if (n > sommetsMax) throw std::invalid_argument("deserialiserArbre: nombre de sommets excessif") ;
+    const size_t source = lireVarintBorne(curseur, fin) ;
+    const size_t atteints = lireVarintBorne(curseur, fin) ;
+    if (source >= n || atteints >= n || atteints > static_cast<size_t>(fin - curseur) / (2 + sizeof(P)))
+        throw std::invalid_argument("deserialiserArbre: en-tête invalide") ;
+
+    ResultatsDijkstraGenerique<P> resultats(n, source) ;
+    size_t suivant = 0 ;
+    for (size_t i = 0; i < atteints; ++i) {
+        uint64_t sommet = suivant + lireVarintBorne(curseur, fin) ;
+        uint64_t zigzag = lireVarintBorne(curseur, fin) ;
+        auto ecart = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1) ;
+        uint64_t predecesseur = sommet + static_cast<uint64_t>(ecart) ;
+        if (sommet < suivant || sommet >= n || sommet == source || predecesseur >= n
+            || static_cast<size_t>(fin - curseur) < sizeof(P))
+            throw std::invalid_argument("deserialiserArbre: données incohérentes") ;
+
+        resultats.predecesseurs[sommet] = predecesseur ;
+        std::memcpy(&resultats.distances[sommet], curseur, sizeof(P)) ;
+        curseur += sizeof(P) ;
+        suivant = sommet + 1 ;
+    }
+    if (curseur != fin) throw std::invalid_argument("deserialiserArbre: données excédentaires") ;
+
+    // Chaque sommet atteint doit remonter à la source, sans cycle: sinon extraireChemin ne terminerait pas.
+    enum Etat : uint8_t {INCONNU, EN_COURS, RELIE} ;
+    std::vector<uint8_t> etats(n, INCONNU) ;
+    etats[source] = RELIE ;
+    for (size_t sommet = 0; sommet < n; ++sommet) {
+        if (resultats.predecesseurs[sommet] == n) continue ;
+        size_t courant = sommet ;
+        while (etats[courant] == INCONNU) {
+            etats[courant] = EN_COURS ;
+            courant = resultats.predecesseurs[courant] ;
+            if (courant == n) throw std::invalid_argument("deserialiserArbre: prédécesseur non atteint") ;
+        }
+        if (etats[courant] == EN_COURS) throw std::invalid_argument("deserialiserArbre: cycle de prédécesseurs") ;
+        for (courant = sommet; etats[courant] == EN_COURS; courant = resultats.predecesseurs[courant])
+            etats[courant] = RELIE ;
     }
-    resultats.distances = nonResolus.genererIndex() ;
     return resultats ;
 }
+
+namespace {
+
+    /**
+     * Calcule le degré non orienté (arité d'entrée plus arité de sortie) de chaque sommet, en une seule passe.
+     */
+    template <typename S, typename P>
+    std::vector<size_t> degresNonOrientes(const GrapheGenerique<S, P>& graphe) {
+        std::vector<size_t> degres(graphe.taille(), 0) ;
+        for (size_t sommet = 0; sommet < graphe.taille(); ++sommet) {
+            degres[sommet] += graphe.ariteSortie(sommet) ;
+            for (const auto& arc: graphe.enumererVoisins(sommet)) ++ degres[arc.destination] ;
+        }
+        return degres ;
+    }
+
+}
+
+/**
+ * Renumérote les sommets par degré non orienté décroissant: les sommets les plus sollicités, regroupés au début, se
+ * partagent ainsi les mêmes lignes de cache.  L'ordre d'origine départage les égalités.
+ * @param graphe Objet graphe à renuméroter
+ * @return La permutation
+ */
+template <typename S, typename P>
+Permutation ordreDegres(const GrapheGenerique<S, P>& graphe) {
+    const auto degres = degresNonOrientes(graphe) ;
+    std::vector<size_t> ordre(graphe.taille()) ;
+    std::iota(ordre.begin(), ordre.end(), 0) ;
+    std::stable_sort(ordre.begin(), ordre.end(), [&degres](size_t a, size_t b) {return degres[a] > degres[b] ; }) ;
+    return Permutation(std::move(ordre)) ;
+}
+
+/**
+ * Renumérotation de Cuthill-McKee inverse (RCM) sur la vue non orientée du graphe.  Chaque composante est parcourue
+ * en largeur à partir d'un de ses sommets de degré minimal, les voisins étant visités par degré croissant; l'ordre
+ * obtenu est ensuite inversé.  Les sommets voisins reçoivent ainsi des numéros proches, ce qui réduit la largeur de
+ * bande de la matrice d'adjacence.
+ * @param graphe Objet graphe à renuméroter
+ * @return La permutation
+ */
+template <typename S, typename P>
+Permutation ordreCuthillMcKeeInverse(const GrapheGenerique<S, P>& graphe) {
+    const size_t n = graphe.taille() ;
+    const auto degres = degresNonOrientes(graphe) ;
+    const GrapheGenerique<S, P> inverse = graphe.grapheInverse() ;
+
+    std::vector<size_t> candidats(n) ;
+    std::iota(candidats.begin(), candidats.end(), 0) ;
+    std::stable_sort(candidats.begin(), candidats.end(), [&degres](size_t a, size_t b) {return degres[a] < degres[b] ; }) ;
+
+    std::vector<size_t> ordre ;
+    ordre.reserve(n) ;
+    std::vector<bool> visites(n, false) ;
+    std::vector<size_t> voisins ;
+    for (auto racine: candidats) {
+        if (visites[racine]) continue ;
+        visites[racine] = true ;
+        ordre.push_back(racine) ;
+        for (size_t i = ordre.size() - 1; i < ordre.size(); ++i) {
+            size_t courant = ordre[i] ;
+            voisins.clear() ;
+            for (const auto* liste: {&graphe.enumererVoisins(courant), &inverse.enumererVoisins(courant)})
+                for (const auto& arc: *liste)
+                    if (!visites[arc.destination]) {
+                        visites[arc.destination] = true ;
+                        voisins.push_back(arc.destination) ;
+                    }
+            std::stable_sort(voisins.begin(), voisins.end(), [&degres](size_t a, size_t b) {return degres[a] < degres[b] ; }) ;
+            ordre.insert(ordre.end(), voisins.begin(), voisins.end()) ;
+        }
+    }
+
+    std::reverse(ordre.begin(), ordre.end()) ;
+    return Permutation(std::move(ordre)) ;
+}
+
+/**
+ * Renumérotation Gorder (Wei et al., 2016), version gloutonne.  Les sommets sont placés un à un; le prochain est celui
+ * qui a le meilleur score avec les sommets des dernières positions (la fenêtre).  Le score de deux sommets compte les
+ * arcs qui les relient et leurs prédécesseurs communs, qui seront vraisemblablement lus ensemble lors d'un parcours.
+ * Les scores sont tenus à jour incrémentalement à l'entrée et à la sortie de chaque sommet de la fenêtre.  Comme dans
+ * l'article, les sommets de très haut degré (plus de racine de n successeurs) ne servent pas à calculer les
+ * prédécesseurs communs, ce qui borne le coût des mises à jour.
+ * @param graphe Objet graphe à renuméroter
+ * @param fenetre Nombre de sommets récemment placés pris en compte
+ * @return La permutation
+ */
+template <typename S, typename P>
+Permutation ordreGorder(const GrapheGenerique<S, P>& graphe, size_t fenetre) {
+    const size_t n = graphe.taille() ;
+    const GrapheGenerique<S, P> inverse = graphe.grapheInverse() ;
+    const size_t seuilPivot = static_cast<size_t>(std::sqrt(static_cast<double>(n))) + 1 ;
+
+    std::vector<long> scores(n, 0) ;
+    std::vector<bool> places(n, false) ;
+    std::set<std::pair<long, size_t>> file ;
+    for (size_t sommet = 0; sommet < n; ++sommet) file.emplace(0, sommet) ;
+
+    // Sommets non placés par arité d'entrée, pour les départs de composante.  La clé (arité, n - sommet) fait passer le
+    // plus petit numéro en dernier à arité égale.
+    std::set<std::pair<size_t, size_t>> parArite ;
+    for (size_t sommet = 0; sommet < n; ++sommet) parArite.emplace(inverse.ariteSortie(sommet), n - sommet) ;
+
+    auto modifierScore = [&](size_t sommet, long increment) {
+        if (places[sommet]) return ;
+        file.erase({scores[sommet], sommet}) ;
+        scores[sommet] += increment ;
+        file.emplace(scores[sommet], sommet) ;
+    } ;
+    auto mettreAJour = [&](size_t sommet, long increment) {
+        for (const auto& arc: graphe.enumererVoisins(sommet)) modifierScore(arc.destination, increment) ;
+        for (const auto& arc: inverse.enumererVoisins(sommet)) {
+            modifierScore(arc.destination, increment) ;
+            if (graphe.ariteSortie(arc.destination) > seuilPivot) continue ;
+            for (const auto& frere: graphe.enumererVoisins(arc.destination))
+                if (frere.destination != sommet) modifierScore(frere.destination, increment) ;
+        }
+    } ;
+
+    std::vector<size_t> ordre ;
+    ordre.reserve(n) ;
+    while (!file.empty()) {
+        size_t choisi ;
+        if (ordre.empty() || file.rbegin()->first == 0) choisi = n - parArite.rbegin()->second ;
+        else choisi = file.rbegin()->second ;
+
+        file.erase({scores[choisi], choisi}) ;
+        parArite.erase({inverse.ariteSortie(choisi), n - choisi}) ;
+        places[choisi] = true ;
+        ordre.push_back(choisi) ;
+        mettreAJour(choisi, 1) ;
+        if (ordre.size() > fenetre) mettreAJour(ordre[ordre.size() - 1 - fenetre], -1) ;
+    }
+    return Permutation(std::move(ordre)) ;
+}
+
+/**
+ * Construit le graphe renuméroté selon une permutation.  Les arcs de chaque sommet sont rangés par numéro de
+ * destination croissant, de sorte qu'un parcours de la liste avance dans la mémoire des sommets voisins.
+ * @param graphe Objet graphe à renuméroter
+ * @param permutation Permutation à appliquer, obtenue par exemple de ordreCuthillMcKeeInverse
+ * @return Un graphe isomorphe, où l'ancien sommet v porte le numéro permutation.nouveaux[v]
+ * @except std::invalid_argument si la permutation n'a pas la taille du graphe
+ */
+template <typename S, typename P>
+GrapheGenerique<S, P> appliquerPermutation(const GrapheGenerique<S, P>& graphe, const Permutation& permutation) {
+    const size_t n = graphe.taille() ;
+    if (permutation.anciens.size() != n || permutation.nouveaux.size() != n)
+        throw std::invalid_argument("appliquerPermutation: permutation de taille invalide") ;
+
+    GrapheGenerique<S, P> renumerote(n) ;
+    std::vector<typename GrapheGenerique<S, P>::Arc> arcs ;
+    for (size_t nouveau = 0; nouveau < n; ++nouveau) {
+        arcs.clear() ;
+        for (const auto& arc: graphe.enumererVoisins(permutation.anciens[nouveau]))
+            arcs.emplace_back(permutation.nouveaux[arc.destination], arc.poids) ;
+        std::sort(arcs.begin(), arcs.end(), [](const typename GrapheGenerique<S, P>::Arc& a,
+                                               const typename GrapheGenerique<S, P>::Arc& b) {
+            return a.destination < b.destination ;
+        }) ;
+        for (const auto& arc: arcs) renumerote.ajouterArcDistinct(nouveau, arc.destination, arc.poids) ;
+    }
+    return renumerote ;
+}
+
+// Instanciations pour les types de graphe déclarés dans Graphe.h
+
+#define SIMPLESGRAPHES_INSTANCIER_PARCOURS(S, P) \
+    template std::stack<size_t> exploreRecursifGrapheDFS(const GrapheGenerique<S, P>&) ; \
+    template std::vector<size_t> exploreBFS(const GrapheGenerique<S, P>&, size_t) ; \
+    template std::stack<size_t> exploreIteratifDFS(const GrapheGenerique<S, P>&, size_t) ; \
+    template std::set<std::set<size_t>> kosaraju(const GrapheGenerique<S, P>&) ; \
+    template std::vector<size_t> triTopologique(const GrapheGenerique<S, P>&) ; \
+    template std::vector<size_t> composantesFaiblementConnexes(const GrapheGenerique<S, P>&, ReservoirFils&) ; \
+    template Permutation ordreDegres(const GrapheGenerique<S, P>&) ; \
+    template Permutation ordreCuthillMcKeeInverse(const GrapheGenerique<S, P>&) ; \
+    template Permutation ordreGorder(const GrapheGenerique<S, P>&, size_t) ; \
+    template GrapheGenerique<S, P> appliquerPermutation(const GrapheGenerique<S, P>&, const Permutation&) ; \
+    template const std::vector<SommetAtteint<size_t>>& voisinageSauts(const GrapheGenerique<S, P>&, size_t, size_t, \
+                                                                      EspaceVoisinage<size_t>&) ; \
+    template EtatIteratif<double> pageRank(const GrapheGenerique<S, P>&, const ParametresPageRank&, ReservoirFils&) ; \
+    template std::vector<double> intermediarite(const GrapheGenerique<S, P>&, const ParametresIntermediarite&, ReservoirFils&) ;
+
+#define SIMPLESGRAPHES_INSTANCIER_CHEMINS(S, P) \
+    template ResultatsDijkstraGenerique<P> dijkstra(const GrapheGenerique<S, P>&, size_t) ; \
+    template ResultatsDijkstraGenerique<P> dijkstraFilePrioritaire(const GrapheGenerique<S, P>&, size_t) ; \
+    template ResultatsDijkstraGenerique<P> bellmanFord(const GrapheGenerique<S, P>&, size_t, ReservoirFils&) ; \
+    template ResultatsJohnson<S, P> johnson(const GrapheGenerique<S, P>&, bool, ReservoirFils&) ; \
+    template void johnsonVersFichier(const GrapheGenerique<S, P>&, const std::string&, ReservoirFils&) ; \
+    template ForetCouvrante<P> prim(const GrapheGenerique<S, P>&) ; \
+    template ForetCouvrante<P> kruskal(const GrapheGenerique<S, P>&) ; \
+    template ForetCouvrante<P> boruvka(const GrapheGenerique<S, P>&, ReservoirFils&) ; \
+    template ResultatsFlot<P> flotMaximal(const GrapheGenerique<S, P>&, size_t, size_t) ; \
+    template const std::vector<SommetAtteint<P>>& voisinageRayon(const GrapheGenerique<S, P>&, size_t, P, EspaceVoisinage<P>&) ; \
+    template P cheminPlusCourt(const GrapheGenerique<S, P>&, size_t, size_t, EspaceVoisinage<P>&, std::vector<size_t>&) ; \
+    template P extraireChemin(const ResultatsDijkstraGenerique<P>&, size_t, std::vector<size_t>&) ; \
+    template CheminTrouve<P> cheminPlusCourt(const GrapheGenerique<S, P>&, size_t, size_t) ; \
+    template void serialiserArbre(const ResultatsDijkstraGenerique<P>&, std::vector<uint8_t>&) ; \
+    template ResultatsDijkstraGenerique<P> deserialiserArbre(const std::vector<uint8_t>&, size_t) ;
+
+SIMPLESGRAPHES_INSTANCIER_PARCOURS(size_t, double)
+SIMPLESGRAPHES_INSTANCIER_PARCOURS(uint32_t, float)
+SIMPLESGRAPHES_INSTANCIER_PARCOURS(uint32_t, uint32_t)
+SIMPLESGRAPHES_INSTANCIER_PARCOURS(uint32_t, SansPoids)
+
+#define SIMPLESGRAPHES_INSTANCIER_COMPRESSE(P) \
+    template std::vector<size_t> exploreBFS(const GrapheCompresse<P>&, size_t) ; \
+    template std::set<std::set<size_t>> kosaraju(const GrapheCompresse<P>&) ; \
+    template EtatIteratif<double> pageRank(const GrapheCompresse<P>&, const ParametresPageRank&, ReservoirFils&) ;
+
+SIMPLESGRAPHES_INSTANCIER_COMPRESSE(double)
+SIMPLESGRAPHES_INSTANCIER_COMPRESSE(float)
+SIMPLESGRAPHES_INSTANCIER_COMPRESSE(uint32_t)
+SIMPLESGRAPHES_INSTANCIER_COMPRESSE(SansPoids)
+
+SIMPLESGRAPHES_INSTANCIER_CHEMINS(size_t, double)
+SIMPLESGRAPHES_INSTANCIER_CHEMINS(uint32_t, float)
+SIMPLESGRAPHES_INSTANCIER_CHEMINS(uint32_t, uint32_t)
@@ -6,39 +6,312 @@
 #define SIMPLESGRAPHES_GRAPHE_ALGORITHMES_H
 
 #include "Graphe.h"
+#include "GrapheCompresse.h"
+#include "ParcoursProfondeur.h"
 #include "FilePrioritaire.h"
+#include "ReservoirFils.h"
+#include "EnsemblesDisjoints.h"
+#include "ProgrammeSommets.h"
+#include "Varint.h"
 
 #include <stack>
 #include <set>
 #include <queue>
 #include <numeric>
 #include <limits>
+#include <utility>
+#include <string>
+#include <cstdint>
+#include <functional>
 
 
-using ResultatsDijkstra = struct resultatsDijkstra {
+template <typename P>
+struct ResultatsDijkstraGenerique {
     std::vector<size_t> predecesseurs ;
-    std::vector<double> distances ;
+    std::vector<P> distances ;
 
-    explicit resultatsDijkstra(size_t n, size_t d) : predecesseurs(n, n), distances(n, std::numeric_limits<double>::infinity()) {
+    explicit ResultatsDijkstraGenerique(size_t n, size_t d) : predecesseurs(n, n), distances(n, TraitsPoids<P>::infini()) {
         distances.at(d) = 0 ;
     } ;
 };
 
-// Déclarations des fonctions accessibles
+using ResultatsDijkstra = ResultatsDijkstraGenerique<double> ;
 
-std::stack<size_t> exploreRecursifGrapheDFS(const Graphe& graphe) ;
+/**
+ * @struct CheminTrouve Un plus court chemin entre deux sommets: sa longueur et ses sommets, du départ à l'arrivée.
+ * Sommets vide et longueur infinie si l'arrivée est inaccessible.
+ */
+template <typename P>
+struct CheminTrouve {
+    P longueur ;
+    std::vector<size_t> sommets ;
+};
+
+/**
+ * @struct ResultatsJohnson Matrices des plus courts chemins entre toutes les paires de sommets, rangées ligne par ligne
+ * dans des vecteurs contigus: l'élément (u, v) se trouve à la position n * u + v.  La matrice des prédécesseurs n'est
+ * remplie que sur demande; elle utilise le type de sommet du graphe, et la valeur n y indique l'absence de prédécesseur.
+ */
+template <typename S, typename P>
+struct ResultatsJohnson {
+    size_t n ;
+    std::vector<P> distances ;
+    std::vector<S> predecesseurs ;
+
+    ResultatsJohnson(size_t n, bool avecPredecesseurs) : n(n), distances(n * n, TraitsPoids<P>::infini()),
+                                                         predecesseurs(avecPredecesseurs ? n * n : 0, static_cast<S>(n)) {}
+
+    P distance(size_t u, size_t v) const {return distances.at(n * u + v) ; }
+    size_t predecesseur(size_t u, size_t v) const {return predecesseurs.at(n * u + v) ; }
+};
+
+/**
+ * @struct AreteNonOrientee Arête de la vue non orientée d'un graphe: les arcs u -> v et v -> u y sont confondus.
+ */
+template <typename P>
+struct AreteNonOrientee {
+    size_t u ;
+    size_t v ;
+    P poids ;
+
+    bool operator == (const AreteNonOrientee& rhs) const {return u == rhs.u && v == rhs.v && poids == rhs.poids ; }
+};
+
+/**
+ * @struct ForetCouvrante Arbre (ou forêt, si le graphe n'est pas connexe) couvrant de poids minimal: ses arêtes et la
+ * somme de leurs poids.
+ */
+template <typename P>
+struct ForetCouvrante {
+    std::vector<AreteNonOrientee<P>> aretes ;
+    P poidsTotal ;
+
+    ForetCouvrante() : aretes(), poidsTotal(0) {}
+};
+
+/**
+ * @struct ResultatsFlot Résultat d'un calcul de flot maximal: la valeur du flot et la coupe minimale correspondante.
+ * coteSource[v] est true si le sommet v est du côté de la source dans la coupe.
+ */
+template <typename P>
+struct ResultatsFlot {
+    P valeur ;
+    std::vector<bool> coteSource ;
+};
+
+/**
+ * @struct ParametresPageRank Paramètres de pageRank.
+ *
+ * amortissement: probabilité de suivre un arc plutôt que de se téléporter.
+ * tolerance: un sommet dont le score varie de moins que cette valeur cesse d'être recalculé.
+ * iterationsMax: limite du nombre d'itérations.
+ * personnalisation: distribution de téléportation, une valeur positive ou nulle par sommet, normalisée au besoin.  Si
+ * vide, la distribution uniforme est utilisée.
+ */
+struct ParametresPageRank {
+    double amortissement = 0.85 ;
+    double tolerance = 1e-10 ;
+    size_t iterationsMax = 100 ;
+    std::vector<double> personnalisation ;
+};
+
+/**
+ * @struct ParametresIntermediarite Paramètres de intermediarite.
+ *
+ * ponderee: si true et que le graphe est pondéré, les plus courts chemins tiennent compte des poids (Dijkstra); sinon,
+ * ils comptent les arcs (parcours en largeur).
+ * erreur: si nulle, le calcul est exact.  Sinon, seul un échantillon de sources est exploré, assez grand pour que
+ * l'intermédiarité normalisée (divisée par (n - 1)(n - 2)) de chaque sommet soit exacte à plus ou moins erreur près.
+ * probabiliteEchec: probabilité que la borne d'erreur ne soit pas respectée, en mode approximatif.
+ * graine: graine du générateur aléatoire utilisé pour choisir l'échantillon.
+ */
+struct ParametresIntermediarite {
+    bool ponderee = true ;
+    double erreur = 0 ;
+    double probabiliteEchec = 0.1 ;
+    unsigned graine = 0 ;
+};
+
+/**
+ * @struct SommetAtteint Un sommet atteint par une requête de voisinage, avec sa distance au départ (en sauts ou en
+ * poids) et son prédécesseur sur un plus court chemin.  Le départ est son propre prédécesseur.
+ */
+template <typename D>
+struct SommetAtteint {
+    size_t sommet ;
+    D distance ;
+    size_t predecesseur ;
+
+    bool operator == (const SommetAtteint& rhs) const {
+        return sommet == rhs.sommet && distance == rhs.distance && predecesseur == rhs.predecesseur ;
+    }
+};
+
+/**
+ * @struct EspaceVoisinage Espace de travail réutilisable pour voisinageSauts, voisinageRayon et cheminPlusCourt.  Ses
+ * tableaux par sommet sont alloués une seule fois, puis invalidés d'une requête à l'autre par un simple changement de
+ * génération: un sommet n'est considéré comme atteint que si sa marque égale la génération courante.  Une requête ne
+ * touche ainsi que les sommets de son voisinage.  Le vecteur resultats contient la réponse de la dernière requête.
+ *
+ * Un espace ne doit servir qu'à une requête à la fois; chaque fil doit avoir le sien.
+ */
+template <typename D>
+struct EspaceVoisinage {
+    std::vector<SommetAtteint<D>> resultats ;
+    std::vector<D> distances ;
+    std::vector<size_t> predecesseurs ;
+    std::vector<uint32_t> atteints ;
+    std::vector<uint32_t> fixes ;
+    std::vector<std::pair<D, size_t>> tas ;
+    uint32_t generation = 0 ;
+
+    void preparer(size_t n) {
+        if (atteints.size() < n) {
+            distances.resize(n) ;
+            predecesseurs.resize(n) ;
+            atteints.resize(n, 0) ;
+            fixes.resize(n, 0) ;
+        }
+        if (++ generation == 0) {
+            std::fill(atteints.begin(), atteints.end(), 0) ;
+            std::fill(fixes.begin(), fixes.end(), 0) ;
+            generation = 1 ;
+        }
+        resultats.clear() ;
+        tas.clear() ;
+    }
+};
+
+/**
+ * @struct Permutation Renumérotation des sommets d'un graphe.  nouveaux[ancien] donne le nouveau numéro d'un sommet et
+ * anciens[nouveau] son numéro d'origine.  versAnciens ramène dans la numérotation d'origine un vecteur de valeurs
+ * calculées par sommet sur le graphe renuméroté.
+ */
+struct Permutation {
+    std::vector<size_t> nouveaux ;
+    std::vector<size_t> anciens ;
+
+    explicit Permutation(std::vector<size_t> ordre) : nouveaux(ordre.size()), anciens(std::move(ordre)) {
+        for (size_t nouveau = 0; nouveau < anciens.size(); ++nouveau) nouveaux.at(anciens[nouveau]) = nouveau ;
+    }
+
+    template <typename T>
+    std::vector<T> versAnciens(const std::vector<T>& valeurs) const {
+        std::vector<T> resultat(valeurs) ;
+        for (size_t nouveau = 0; nouveau < anciens.size(); ++nouveau) resultat.at(anciens[nouveau]) = valeurs.at(nouveau) ;
+        return resultat ;
+    }
+};
+
+// Déclarations des fonctions accessibles.  Elles sont instanciées dans Graphe_algorithmes.cpp pour chacun des types de
+// graphe déclarés dans Graphe.h; les plus courts chemins ne le sont évidemment que pour les graphes pondérés.
+
+template <typename S, typename P>
+std::stack<size_t> exploreRecursifGrapheDFS(const GrapheGenerique<S, P>& graphe) ;
+
+template <typename S, typename P>
+std::vector<size_t> exploreBFS(const GrapheGenerique<S, P>& graphe, size_t depart) ;
+
+template <typename S, typename P>
+std::stack<size_t> exploreIteratifDFS(const GrapheGenerique<S, P>& graphe, size_t depart) ;
+
+template <typename S, typename P>
+std::set<std::set<size_t>> kosaraju(const GrapheGenerique<S, P>& graphe) ;
+
+template <typename P>
+std::vector<size_t> exploreBFS(const GrapheCompresse<P>& graphe, size_t depart) ;
+
+template <typename P>
+std::set<std::set<size_t>> kosaraju(const GrapheCompresse<P>& graphe) ;
+
+template <typename S, typename P>
+std::vector<size_t> triTopologique(const GrapheGenerique<S, P>& graphe) ;
+
+template <typename S, typename P>
+ResultatsDijkstraGenerique<P> dijkstra(const GrapheGenerique<S, P>& graphe, size_t depart) ;
+
+template <typename S, typename P>
+ResultatsDijkstraGenerique<P> dijkstraFilePrioritaire(const GrapheGenerique<S, P>& graphe, size_t depart) ;
+
+template <typename S, typename P>
+ResultatsDijkstraGenerique<P> bellmanFord(const GrapheGenerique<S, P>& graphe, size_t depart,
+                                          ReservoirFils& reservoir = ReservoirFils::parDefaut()) ;
+
+template <typename S, typename P>
+std::vector<size_t> composantesFaiblementConnexes(const GrapheGenerique<S, P>& graphe,
+                                                  ReservoirFils& reservoir = ReservoirFils::parDefaut()) ;
+
+template <typename S, typename P>
+const std::vector<SommetAtteint<size_t>>& voisinageSauts(const GrapheGenerique<S, P>& graphe, size_t depart,
+                                                         size_t sautsMax, EspaceVoisinage<size_t>& espace) ;
+
+template <typename S, typename P>
+const std::vector<SommetAtteint<P>>& voisinageRayon(const GrapheGenerique<S, P>& graphe, size_t depart, P rayon,
+                                                    EspaceVoisinage<P>& espace) ;
+
+template <typename P>
+P extraireChemin(const ResultatsDijkstraGenerique<P>& resultats, size_t destination, std::vector<size_t>& chemin) ;
+
+template <typename S, typename P>
+P cheminPlusCourt(const GrapheGenerique<S, P>& graphe, size_t depart, size_t arrivee, EspaceVoisinage<P>& espace,
+                  std::vector<size_t>& chemin) ;
+
+template <typename S, typename P>
+CheminTrouve<P> cheminPlusCourt(const GrapheGenerique<S, P>& graphe, size_t depart, size_t arrivee) ;
+
+bool extraireCheminBFS(const std::vector<size_t>& predecesseurs, size_t depart, size_t destination,
+                       std::vector<size_t>& chemin) ;
+
+template <typename P>
+void serialiserArbre(const ResultatsDijkstraGenerique<P>& resultats, std::vector<uint8_t>& octets) ;
+
+template <typename P>
+ResultatsDijkstraGenerique<P> deserialiserArbre(const std::vector<uint8_t>& octets, size_t sommetsMax) ;
+
+template <typename S, typename P>
+Permutation ordreDegres(const GrapheGenerique<S, P>& graphe) ;
+
+template <typename S, typename P>
+Permutation ordreCuthillMcKeeInverse(const GrapheGenerique<S, P>& graphe) ;
+
+template <typename S, typename P>
+Permutation ordreGorder(const GrapheGenerique<S, P>& graphe, size_t fenetre = 5) ;
+
+template <typename S, typename P>
+GrapheGenerique<S, P> appliquerPermutation(const GrapheGenerique<S, P>& graphe, const Permutation& permutation) ;
+
+template <typename S, typename P>
+std::vector<double> intermediarite(const GrapheGenerique<S, P>& graphe,
+                                   const ParametresIntermediarite& parametres = ParametresIntermediarite(),
+                                   ReservoirFils& reservoir = ReservoirFils::parDefaut()) ;
+
+template <typename S, typename P>
+ResultatsJohnson<S, P> johnson(const GrapheGenerique<S, P>& graphe, bool avecPredecesseurs = false,
+                               ReservoirFils& reservoir = ReservoirFils::parDefaut()) ;
+
+template <typename S, typename P>
+void johnsonVersFichier(const GrapheGenerique<S, P>& graphe, const std::string& chemin,
+                        ReservoirFils& reservoir = ReservoirFils::parDefaut()) ;
 
-std::vector<size_t> exploreBFS(const Graphe& graphe, size_t depart) ;
+template <typename S, typename P>
+ForetCouvrante<P> prim(const GrapheGenerique<S, P>& graphe) ;
 
-std::stack<size_t> exploreIteratifDFS(const Graphe& graphe, size_t depart) ;
+template <typename S, typename P>
+ForetCouvrante<P> kruskal(const GrapheGenerique<S, P>& graphe) ;
 
-std::set<std::set<size_t>> kosaraju(const Graphe& graphe) ;
+template <typename S, typename P>
+ForetCouvrante<P> boruvka(const GrapheGenerique<S, P>& graphe, ReservoirFils& reservoir = ReservoirFils::parDefaut()) ;
 
-std::vector<size_t> triTopologique(const Graphe& graphe) ;
+template <typename S, typename P>
+ResultatsFlot<P> flotMaximal(const GrapheGenerique<S, P>& graphe, size_t source, size_t puits) ;
 
-ResultatsDijkstra dijkstra(const Graphe& graphe, size_t depart) ;
+template <typename S, typename P>
+EtatIteratif<double> pageRank(const GrapheGenerique<S, P>& graphe, const ParametresPageRank& parametres = ParametresPageRank(),
+                              ReservoirFils& reservoir = ReservoirFils::parDefaut()) ;
 
-ResultatsDijkstra dijkstraFilePrioritaire(const Graphe& graphe, size_t depart) ;
+template <typename P>
+EtatIteratif<double> pageRank(const GrapheCompresse<P>& graphe, const ParametresPageRank& parametres = ParametresPageRank(),
+                              ReservoirFils& reservoir = ReservoirFils::parDefaut()) ;
 
 
 
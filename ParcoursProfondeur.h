@@ -0,0 +1,199 @@
+//
+// Created by Pascal Charpentier on 2023-07-25.
+//
+
+#ifndef SIMPLESGRAPHES_PARCOURSPROFONDEUR_H
+#define SIMPLESGRAPHES_PARCOURSPROFONDEUR_H
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * Nature d'un arc rencontré pendant un parcours en profondeur:
+ *
+ * ARBRE: mène à un sommet jamais vu, qui devient un enfant de l'origine.
+ * RETOUR: mène à un ancêtre encore en cours d'exploration (ou à l'origine elle-même): il ferme un cycle.
+ * AVANT: mène à un descendant déjà terminé.
+ * TRANSVERSE: mène à un sommet terminé qui n'est pas un descendant, exploré plus tôt.
+ */
+enum class TypeArc {ARBRE, RETOUR, AVANT, TRANSVERSE} ;
+
+/**
+ * @struct VisiteurProfondeur Visiteur qui ne fait rien.  Un visiteur en dérive et redéfinit les seules méthodes qui
+ * l'intéressent: l'appel est résolu à la compilation et s'insère dans la boucle du parcours.
+ *
+ * demarrer(racine): une nouvelle arborescence commence.
+ * decouvrir(sommet): le sommet est atteint pour la première fois.
+ * arc(origine, arc, type): un arc sortant de l'origine est examiné.  Pour un arc d'ARBRE, l'appel précède la
+ * découverte de la destination.
+ * terminer(sommet, parent): tous les arcs du sommet ont été examinés; parent est son parent dans l'arborescence, ou
+ * graphe.taille() pour une racine.
+ * interrompre(): vérifiée après chaque arc; si elle retourne true, le parcours s'arrête aussitôt.
+ */
+struct VisiteurProfondeur {
+    void demarrer(size_t) {}
+    void decouvrir(size_t) {}
+    template <typename Arc>
+    void arc(size_t, const Arc&, TypeArc) {}
+    void terminer(size_t, size_t) {}
+    bool interrompre() const {return false ; }
+};
+
+/**
+ * @class ParcoursProfondeur
+ *
+ * Moteur de parcours en profondeur itératif.  La pile explicite conserve, pour chaque sommet en cours, un curseur sur
+ * sa liste d'arcs: chaque arc est examiné une seule fois, le parcours est en O(n + m) et sa profondeur n'est limitée
+ * que par la mémoire, jamais par la pile d'appels.  Les voisins sont examinés dans l'ordre de enumererVoisins, de
+ * sorte que l'ordre de découverte et de terminaison est celui d'un parcours récursif.
+ *
+ * L'état (sommets découverts et terminés) persiste d'un appel à explorer au suivant: des appels successifs avec des
+ * racines choisies par l'appelant forment une forêt, comme la seconde passe de kosaraju.
+ *
+ * @tparam G Type du graphe: GrapheGenerique ou GrapheCompresse, ou tout type offrant taille, sommetExiste et
+ * enumererVoisins.  Le graphe n'est pas copié et ne doit pas être modifié pendant le parcours.
+ */
+template <typename G>
+class ParcoursProfondeur {
+public:
+    explicit ParcoursProfondeur(const G& graphe)
+        : graphe(graphe), decouvertes(graphe.taille(), graphe.taille()), termines(graphe.taille(), false), pile(),
+          compteur(0) {}
+
+    template <typename Visiteur>
+    bool explorer(size_t racine, Visiteur& visiteur) ;
+
+    template <typename Visiteur>
+    bool explorerTout(Visiteur& visiteur) ;
+
+    /**
+     * @return true si le sommet a déjà été atteint par un parcours
+     */
+    bool   decouvert(size_t sommet)                           const {return decouvertes[sommet] != graphe.taille() ; }
+
+    /**
+     * @return Le rang du sommet dans l'ordre de découverte, ou graphe.taille() s'il n'a pas été atteint
+     */
+    size_t rangDecouverte(size_t sommet)                      const {return decouvertes[sommet] ; }
+
+private:
+    using IterateurArcs = decltype(std::declval<const G&>().enumererVoisins(0).begin()) ;
+
+    /**
+     * @struct Cadre Un sommet en cours d'exploration et sa position dans sa liste d'arcs.
+     */
+    struct Cadre {
+        size_t        sommet ;
+        IterateurArcs courant ;
+        IterateurArcs fin ;
+    };
+
+    template <typename Visiteur>
+    void decouvrir(size_t sommet, Visiteur& visiteur) ;
+
+    const G&            graphe ;
+    std::vector<size_t> decouvertes ;
+    std::vector<bool>   termines ;
+    std::vector<Cadre>  pile ;
+    size_t              compteur ;
+};
+
+/**
+ * Parcourt en profondeur l'arborescence issue d'une racine.  Rien n'est fait si la racine a déjà été découverte.
+ * @param racine Numéro du sommet de départ
+ * @param visiteur Reçoit les événements du parcours
+ * @return false si le visiteur a interrompu le parcours
+ * @except std::invalid_argument si la racine n'est pas dans le graphe
+ */
+template <typename G>
+template <typename Visiteur>
+bool ParcoursProfondeur<G>::explorer(size_t racine, Visiteur& visiteur) {
+    if (!graphe.sommetExiste(racine)) throw std::invalid_argument("ParcoursProfondeur::explorer: racine invalide") ;
+    if (decouvert(racine)) return true ;
+
+    visiteur.demarrer(racine) ;
+    decouvrir(racine, visiteur) ;
+    while (!pile.empty()) {
+        Cadre& cadre = pile.back() ;
+        if (cadre.courant == cadre.fin) {
+            size_t sommet = cadre.sommet ;
+            pile.pop_back() ;
+            termines[sommet] = true ;
+            visiteur.terminer(sommet, pile.empty() ? graphe.taille() : pile.back().sommet) ;
+            continue ;
+        }
+
+        const auto& arc = *cadre.courant ;
+        const size_t origine = cadre.sommet, destination = arc.destination ;
+        if (!decouvert(destination)) {
+            visiteur.arc(origine, arc, TypeArc::ARBRE) ;
+            ++ cadre.courant ;
+            decouvrir(destination, visiteur) ;    // Invalide cadre
+        }
+        else {
+            TypeArc type = !termines[destination] ? TypeArc::RETOUR
+                         : decouvertes[destination] > decouvertes[origine] ? TypeArc::AVANT : TypeArc::TRANSVERSE ;
+            visiteur.arc(origine, arc, type) ;
+            ++ cadre.courant ;
+        }
+        if (visiteur.interrompre()) {
+            pile.clear() ;
+            return false ;
+        }
+    }
+    return true ;
+}
+
+/**
+ * Parcourt en profondeur tout le graphe, en prenant pour racines les sommets non découverts en ordre croissant.
+ * @param visiteur Reçoit les événements du parcours
+ * @return false si le visiteur a interrompu le parcours
+ */
+template <typename G>
+template <typename Visiteur>
+bool ParcoursProfondeur<G>::explorerTout(Visiteur& visiteur) {
+    for (size_t racine = 0; racine < graphe.taille(); ++racine)
+        if (!explorer(racine, visiteur)) return false ;
+    return true ;
+}
+
+/**
+ * Marque un sommet découvert et l'empile avec un curseur au début de sa liste d'arcs.
+ */
+template <typename G>
+template <typename Visiteur>
+void ParcoursProfondeur<G>::decouvrir(size_t sommet, Visiteur& visiteur) {
+    decouvertes[sommet] = compteur ++ ;
+    visiteur.decouvrir(sommet) ;
+    const auto& voisins = graphe.enumererVoisins(sommet) ;
+    pile.push_back(Cadre {sommet, voisins.begin(), voisins.end()}) ;
+}
+
+/**
+ * Parcourt en profondeur tout le graphe.
+ * @param graphe Le graphe à parcourir
+ * @param visiteur Reçoit les événements du parcours
+ * @return false si le visiteur a interrompu le parcours
+ */
+template <typename G, typename Visiteur>
+bool parcourirProfondeur(const G& graphe, Visiteur& visiteur) {
+    ParcoursProfondeur<G> parcours(graphe) ;
+    return parcours.explorerTout(visiteur) ;
+}
+
+/**
+ * Parcourt en profondeur les sommets accessibles à partir d'une racine.
+ * @param graphe Le graphe à parcourir
+ * @param racine Numéro du sommet de départ
+ * @param visiteur Reçoit les événements du parcours
+ * @return false si le visiteur a interrompu le parcours
+ * @except std::invalid_argument si la racine n'est pas dans le graphe
+ */
+template <typename G, typename Visiteur>
+bool parcourirProfondeur(const G& graphe, size_t racine, Visiteur& visiteur) {
+    ParcoursProfondeur<G> parcours(graphe) ;
+    return parcours.explorer(racine, visiteur) ;
+}
+
+#endif //SIMPLESGRAPHES_PARCOURSPROFONDEUR_H
@@ -0,0 +1,518 @@
+//
+// Created by Pascal Charpentier on 2023-07-14.
+//
+
+#include "Partitionnement.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include <dirent.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * Partitionnement en flux de Fennel (Tsourakakis et al., 2014).  Les sommets sont pris un à un et placés dans la partie
+ * qui maximise le nombre de leurs voisins (dans les deux sens) déjà placés, moins une pénalité qui croît avec la taille
+ * de la partie: alpha * ((t + 1)^1.5 - t^1.5), avec alpha = m * racine(k) / n^1.5.  Une partie pleine, qui dépasse
+ * desequilibre * n / k sommets, n'est plus candidate.  Une seule passe sur les arcs suffit.
+ * @param graphe Objet graphe à partitionner
+ * @param nombreParties Nombre de parties k
+ * @param desequilibre Taille maximale d'une partie, relativement à la taille moyenne
+ * @return La partition obtenue
+ * @except std::invalid_argument si le nombre de parties est nul ou le déséquilibre inférieur à 1
+ */
+template <typename S, typename P>
+Partition partitionnerFennel(const GrapheGenerique<S, P>& graphe, size_t nombreParties, double desequilibre) {
+    if (nombreParties == 0) throw std::invalid_argument("partitionnerFennel: nombre de parties nul") ;
+    if (desequilibre < 1.0) throw std::invalid_argument("partitionnerFennel: déséquilibre inférieur à 1") ;
+
+    const size_t n = graphe.taille() ;
+    const GrapheGenerique<S, P> inverse = graphe.grapheInverse() ;
+    size_t m = 0 ;
+    for (size_t sommet = 0; sommet < n; ++sommet) m += graphe.ariteSortie(sommet) ;
+
+    const double gamma = 1.5 ;
+    const double alpha = n == 0 ? 0.0 : m * std::sqrt(static_cast<double>(nombreParties)) / std::pow(n, gamma) ;
+    const double capacite = std::ceil(desequilibre * n / nombreParties) ;
+
+    Partition partition {nombreParties, std::vector<size_t>(n, nombreParties), 0} ;
+    std::vector<size_t> tailles(nombreParties, 0) ;
+    std::vector<size_t> voisinsPlaces(nombreParties, 0) ;
+    std::vector<size_t> touchees ;
+
+    for (size_t sommet = 0; sommet < n; ++sommet) {
+        for (const auto* liste: {&graphe.enumererVoisins(sommet), &inverse.enumererVoisins(sommet)})
+            for (const auto& arc: *liste) {
+                size_t partie = partition.parties[arc.destination] ;
+                if (partie == nombreParties) continue ;
+                if (voisinsPlaces[partie] ++ == 0) touchees.push_back(partie) ;
+            }
+
+        size_t choisie = nombreParties ;
+        double meilleurScore = -std::numeric_limits<double>::infinity() ;
+        for (size_t partie = 0; partie < nombreParties; ++partie) {
+            if (tailles[partie] >= capacite) continue ;
+            double t = static_cast<double>(tailles[partie]) ;
+            double score = voisinsPlaces[partie] - alpha * (std::pow(t + 1, gamma) - std::pow(t, gamma)) ;
+            if (score > meilleurScore || (score == meilleurScore && tailles[partie] < tailles[choisie])) {
+                meilleurScore = score ;
+                choisie = partie ;
+            }
+        }
+
+        partition.parties[sommet] = choisie ;
+        ++ tailles[choisie] ;
+        for (auto partie: touchees) voisinsPlaces[partie] = 0 ;
+        touchees.clear() ;
+    }
+
+    for (size_t sommet = 0; sommet < n; ++sommet)
+        for (const auto& arc: graphe.enumererVoisins(sommet))
+            if (partition.parties[sommet] != partition.parties[arc.destination]) ++ partition.arcsCoupes ;
+    return partition ;
+}
+
+/**
+ * Extrait une partie d'un graphe partitionné: ses sommets, leurs arcs sortants et les sommets fantômes que ces arcs
+ * atteignent dans les autres parties.
+ * @param graphe Objet graphe partitionné
+ * @param partition Partition du graphe
+ * @param numero Numéro de la partie à extraire
+ * @return La partie, numérotée localement
+ * @except std::invalid_argument si la partition ne correspond pas au graphe ou si la partie n'existe pas
+ */
+template <typename S, typename P>
+PartieGraphe<S, P> extrairePartie(const GrapheGenerique<S, P>& graphe, const Partition& partition, size_t numero) {
+    const size_t n = graphe.taille() ;
+    if (partition.parties.size() != n) throw std::invalid_argument("extrairePartie: partition de taille invalide") ;
+    if (numero >= partition.nombreParties) throw std::invalid_argument("extrairePartie: partie inexistante") ;
+
+    PartieGraphe<S, P> partie {numero, 0, {}, {}, GrapheGenerique<S, P>()} ;
+    std::vector<size_t> locaux(n, n) ;
+    for (size_t sommet = 0; sommet < n; ++sommet)
+        if (partition.parties[sommet] == numero) {
+            locaux[sommet] = partie.globaux.size() ;
+            partie.globaux.push_back(sommet) ;
+        }
+    partie.nombreLocaux = partie.globaux.size() ;
+
+    for (size_t i = 0; i < partie.nombreLocaux; ++i)
+        for (const auto& arc: graphe.enumererVoisins(partie.globaux[i]))
+            if (locaux[arc.destination] == n) {
+                locaux[arc.destination] = partie.globaux.size() ;
+                partie.globaux.push_back(arc.destination) ;
+                partie.proprietaires.push_back(partition.parties[arc.destination]) ;
+            }
+
+    partie.graphe = GrapheGenerique<S, P>(partie.globaux.size()) ;
+    for (size_t i = 0; i < partie.nombreLocaux; ++i)
+        for (const auto& arc: graphe.enumererVoisins(partie.globaux[i]))
+            partie.graphe.ajouterArcDistinct(i, locaux[arc.destination], arc.poids) ;
+    return partie ;
+}
+
+namespace {
+
+    void ecrireEntier(std::ofstream& fichier, uint64_t valeur) {
+        fichier.write(reinterpret_cast<const char*>(&valeur), sizeof(valeur)) ;
+    }
+
+    uint64_t lireEntier(std::ifstream& fichier) {
+        uint64_t valeur = 0 ;
+        fichier.read(reinterpret_cast<char*>(&valeur), sizeof(valeur)) ;
+        return valeur ;
+    }
+
+}
+
+/**
+ * Écrit une partie dans un fichier binaire: numéro, nombre de sommets locaux et de fantômes, numéros d'origine,
+ * propriétaires des fantômes, puis pour chaque sommet local son arité suivie de ses arcs (destination locale, poids).
+ * Les entiers sont écrits sur 64 bits et les poids dans la représentation native de P.
+ * @param partie La partie à écrire
+ * @param chemin Chemin du fichier, remplacé s'il existe
+ * @except std::runtime_error si le fichier ne peut être écrit
+ */
+template <typename S, typename P>
+void ecrirePartie(const PartieGraphe<S, P>& partie, const std::string& chemin) {
+    std::ofstream fichier(chemin, std::ios::binary | std::ios::trunc) ;
+    if (!fichier) throw std::runtime_error("ecrirePartie: impossible de créer " + chemin) ;
+
+    ecrireEntier(fichier, partie.numero) ;
+    ecrireEntier(fichier, partie.nombreLocaux) ;
+    ecrireEntier(fichier, partie.proprietaires.size()) ;
+    for (auto global: partie.globaux) ecrireEntier(fichier, global) ;
+    for (auto proprietaire: partie.proprietaires) ecrireEntier(fichier, proprietaire) ;
+    for (size_t i = 0; i < partie.nombreLocaux; ++i) {
+        ecrireEntier(fichier, partie.graphe.ariteSortie(i)) ;
+        for (const auto& arc: partie.graphe.enumererVoisins(i)) {
+            P poids = arc.poids ;
+            ecrireEntier(fichier, arc.destination) ;
+            fichier.write(reinterpret_cast<const char*>(&poids), sizeof(P)) ;
+        }
+    }
+
+    if (!fichier.flush()) throw std::runtime_error("ecrirePartie: erreur d'écriture dans " + chemin) ;
+}
+
+/**
+ * Relit une partie écrite par ecrirePartie.
+ * @param chemin Chemin du fichier
+ * @return La partie
+ * @except std::runtime_error si le fichier ne peut être lu, est tronqué ou désigne un sommet inexistant
+ */
+template <typename S, typename P>
+PartieGraphe<S, P> lirePartie(const std::string& chemin) {
+    std::ifstream fichier(chemin, std::ios::binary) ;
+    if (!fichier) throw std::runtime_error("lirePartie: impossible d'ouvrir " + chemin) ;
+
+    PartieGraphe<S, P> partie {0, 0, {}, {}, GrapheGenerique<S, P>()} ;
+    partie.numero = lireEntier(fichier) ;
+    partie.nombreLocaux = lireEntier(fichier) ;
+    size_t nombreFantomes = lireEntier(fichier) ;
+    if (!fichier) throw std::runtime_error("lirePartie: fichier tronqué " + chemin) ;
+
+    // Chaque sommet local occupe au moins 16 octets (numéro d'origine et arité), chaque fantôme 16 (numéro d'origine et
+    // propriétaire): des comptes que la taille du fichier ne permet pas sont rejetés avant toute allocation.
+    const auto position = fichier.tellg() ;
+    fichier.seekg(0, std::ios::end) ;
+    const uint64_t restants = static_cast<uint64_t>(fichier.tellg() - position) ;
+    fichier.seekg(position) ;
+    const uint64_t sommetsMax = restants / 16 ;
+    if (!fichier || partie.nombreLocaux > sommetsMax || nombreFantomes > sommetsMax - partie.nombreLocaux)
+        throw std::runtime_error("lirePartie: fichier tronqué " + chemin) ;
+
+    partie.globaux.resize(partie.nombreLocaux + nombreFantomes) ;
+    for (auto& global: partie.globaux) global = lireEntier(fichier) ;
+    partie.proprietaires.resize(nombreFantomes) ;
+    for (auto& proprietaire: partie.proprietaires) proprietaire = lireEntier(fichier) ;
+
+    partie.graphe = GrapheGenerique<S, P>(partie.globaux.size()) ;
+    for (size_t i = 0; i < partie.nombreLocaux && fichier; ++i) {
+        size_t arite = lireEntier(fichier) ;
+        for (size_t j = 0; j < arite && fichier; ++j) {
+            size_t destination = lireEntier(fichier) ;
+            P poids {} ;
+            fichier.read(reinterpret_cast<char*>(&poids), sizeof(P)) ;
+            if (!fichier) break ;
+            if (destination >= partie.globaux.size())
+                throw std::runtime_error("lirePartie: destination invalide dans " + chemin) ;
+            partie.graphe.ajouterArcDistinct(i, destination, poids) ;
+        }
+    }
+
+    if (!fichier) throw std::runtime_error("lirePartie: fichier tronqué " + chemin) ;
+    return partie ;
+}
+
+/**
+ * Écrit toutes les parties d'un graphe partitionné, une à la fois, dans les fichiers prefixe0.partie, prefixe1.partie...
+ * @param graphe Objet graphe partitionné
+ * @param partition Partition du graphe
+ * @param prefixe Début du chemin des fichiers
+ * @return Les chemins des fichiers écrits, dans l'ordre des parties
+ */
+template <typename S, typename P>
+std::vector<std::string> ecrirePartitions(const GrapheGenerique<S, P>& graphe, const Partition& partition,
+                                          const std::string& prefixe) {
+    std::vector<std::string> chemins ;
+    for (size_t numero = 0; numero < partition.nombreParties; ++numero) {
+        chemins.push_back(prefixe + std::to_string(numero) + ".partie") ;
+        ecrirePartie(extrairePartie(graphe, partition, numero), chemins.back()) ;
+    }
+    return chemins ;
+}
+
+namespace {
+
+    /**
+     * Message échangé entre le coordonnateur et les processus de travail: une distance proposée pour un sommet, adressée
+     * à la partie qui le possède.
+     */
+    template <typename D>
+    struct MessageBSP {
+        uint64_t partie ;
+        uint64_t sommet ;
+        D distance ;
+    };
+
+    const uint64_t FIN_BSP = std::numeric_limits<uint64_t>::max() ;
+
+    /**
+     * Compte les fils du processus courant, d'après /proc/self/task.
+     * @return Le nombre de fils, ou 0 s'il ne peut être déterminé
+     */
+    size_t nombreFilsProcessus() {
+        DIR* repertoire = ::opendir("/proc/self/task") ;
+        if (!repertoire) return 0 ;
+        size_t nombre = 0 ;
+        while (const dirent* entree = ::readdir(repertoire))
+            if (entree->d_name[0] != '.') ++ nombre ;
+        ::closedir(repertoire) ;
+        return nombre ;
+    }
+
+    void envoyerOctets(int canal, const void* donnees, size_t octets) {
+        const char* curseur = static_cast<const char*>(donnees) ;
+        while (octets > 0) {
+            ssize_t envoyes = ::send(canal, curseur, octets, MSG_NOSIGNAL) ;
+            if (envoyes < 0 && errno == EINTR) continue ;
+            if (envoyes <= 0) throw std::runtime_error("executionRepartie: canal rompu en écriture") ;
+            curseur += envoyes ;
+            octets -= static_cast<size_t>(envoyes) ;
+        }
+    }
+
+    void recevoirOctets(int canal, void* donnees, size_t octets) {
+        char* curseur = static_cast<char*>(donnees) ;
+        while (octets > 0) {
+            ssize_t recus = ::read(canal, curseur, octets) ;
+            if (recus < 0 && errno == EINTR) continue ;
+            if (recus <= 0) throw std::runtime_error("executionRepartie: canal rompu en lecture") ;
+            curseur += recus ;
+            octets -= static_cast<size_t>(recus) ;
+        }
+    }
+
+    template <typename D>
+    void envoyerMessages(int canal, const std::vector<MessageBSP<D>>& messages) {
+        uint64_t nombre = messages.size() ;
+        envoyerOctets(canal, &nombre, sizeof(nombre)) ;
+        if (nombre > 0) envoyerOctets(canal, messages.data(), nombre * sizeof(MessageBSP<D>)) ;
+    }
+
+    template <typename D>
+    bool recevoirMessages(int canal, std::vector<MessageBSP<D>>& messages) {
+        uint64_t nombre = 0 ;
+        recevoirOctets(canal, &nombre, sizeof(nombre)) ;
+        if (nombre == FIN_BSP) return false ;
+        messages.resize(nombre) ;
+        if (nombre > 0) recevoirOctets(canal, messages.data(), nombre * sizeof(MessageBSP<D>)) ;
+        return true ;
+    }
+
+    /**
+     * Boucle d'un processus de travail.  À chaque superétape, il reçoit les distances proposées pour ses sommets,
+     * propage les améliorations dans sa partie par Dijkstra, puis renvoie au coordonnateur la meilleure distance de
+     * chaque fantôme amélioré.  À la fin, il renvoie la distance de chacun de ses sommets locaux.
+     */
+    template <typename S, typename P, typename D>
+    void travailleurBSP(const PartieGraphe<S, P>& partie, int canal,
+                        const std::function<D(const typename GrapheGenerique<S, P>::Arc&)>& longueur) {
+        const size_t nombre = partie.globaux.size() ;
+        std::unordered_map<size_t, size_t> locaux ;
+        for (size_t i = 0; i < partie.nombreLocaux; ++i) locaux.emplace(partie.globaux[i], i) ;
+
+        std::vector<D> distances(nombre, TraitsPoids<D>::infini()) ;
+        std::vector<char> fantomesAmeliores(nombre, 0) ;
+        std::vector<MessageBSP<D>> messages ;
+        std::priority_queue<std::pair<D, size_t>, std::vector<std::pair<D, size_t>>, std::greater<std::pair<D, size_t>>> file ;
+
+        while (recevoirMessages(canal, messages)) {
+            for (const auto& message: messages) {
+                auto trouve = locaux.find(message.sommet) ;
+                if (trouve == locaux.end() || !(message.distance < distances[trouve->second])) continue ;
+                distances[trouve->second] = message.distance ;
+                file.emplace(message.distance, trouve->second) ;
+            }
+
+            std::vector<size_t> sortants ;
+            while (!file.empty()) {
+                auto courant = file.top() ;
+                file.pop() ;
+                if (distances[courant.second] < courant.first) continue ;
+                for (const auto& arc: partie.graphe.enumererVoisins(courant.second)) {
+                    D candidat = courant.first + longueur(arc) ;
+                    if (!(candidat < distances[arc.destination])) continue ;
+                    distances[arc.destination] = candidat ;
+                    if (arc.destination < partie.nombreLocaux) file.emplace(candidat, arc.destination) ;
+                    else if (!fantomesAmeliores[arc.destination]) {
+                        fantomesAmeliores[arc.destination] = 1 ;
+                        sortants.push_back(arc.destination) ;
+                    }
+                }
+            }
+
+            messages.clear() ;
+            for (auto fantome: sortants) {
+                fantomesAmeliores[fantome] = 0 ;
+                messages.push_back({partie.proprietaires[fantome - partie.nombreLocaux], partie.globaux[fantome],
+                                    distances[fantome]}) ;
+            }
+            envoyerMessages(canal, messages) ;
+        }
+
+        messages.clear() ;
+        for (size_t i = 0; i < partie.nombreLocaux; ++i)
+            messages.push_back({partie.numero, partie.globaux[i], distances[i]}) ;
+        envoyerMessages(canal, messages) ;
+    }
+
+    /**
+     * Exécution synchrone en superétapes (BSP) d'un calcul de distances à partir d'une source, un processus par partie.
+     * Chaque processus lit lui-même son fichier de partie: le coordonnateur ne charge jamais le graphe et ne fait que
+     * router les messages d'une superétape à l'autre, par une paire de sockets locales par processus.  Le calcul
+     * s'arrête à la première superétape qui ne produit aucun message.
+     *
+     * Les processus de travail sont créés par fork et, sans exec, allouent, lisent leur fichier et peuvent lever des
+     * exceptions.  Ce n'est sûr que si l'appelant n'a qu'un fil: après un fork, un verrou tenu par un autre fil (celui
+     * de malloc, des flux ou du déroulement des exceptions) le resterait à jamais dans l'enfant.  Cette condition est
+     * vérifiée avant le premier fork.
+     */
+    template <typename S, typename P, typename D>
+    std::vector<D> executionRepartie(const std::vector<std::string>& chemins, size_t depart,
+                                     const std::function<D(const typename GrapheGenerique<S, P>::Arc&)>& longueur) {
+        const size_t k = chemins.size() ;
+        if (k == 0) throw std::invalid_argument("executionRepartie: aucune partie") ;
+        if (nombreFilsProcessus() > 1)
+            throw std::runtime_error("executionRepartie: le processus appelant doit n'avoir qu'un fil") ;
+
+        std::vector<int> canaux ;
+        std::vector<pid_t> processus ;
+        auto nettoyer = [&](bool tuer) {
+            for (auto canal: canaux) ::close(canal) ;
+            canaux.clear() ;
+            bool echec = false ;
+            for (auto pid: processus) {
+                if (tuer) ::kill(pid, SIGKILL) ;
+                int statut = 0 ;
+                while (::waitpid(pid, &statut, 0) < 0 && errno == EINTR) ;
+                if (!WIFEXITED(statut) || WEXITSTATUS(statut) != 0) echec = true ;
+            }
+            processus.clear() ;
+            return !echec ;
+        } ;
+
+        std::vector<D> distances ;
+        try {
+            for (size_t numero = 0; numero < k; ++numero) {
+                int paire[2] ;
+                if (::socketpair(AF_UNIX, SOCK_STREAM, 0, paire) != 0)
+                    throw std::runtime_error("executionRepartie: socketpair a échoué") ;
+                pid_t pid = ::fork() ;
+                if (pid < 0) {
+                    ::close(paire[0]) ;
+                    ::close(paire[1]) ;
+                    throw std::runtime_error("executionRepartie: fork a échoué") ;
+                }
+                if (pid == 0) {
+                    for (auto canal: canaux) ::close(canal) ;
+                    ::close(paire[0]) ;
+                    int code = 0 ;
+                    try {
+                        travailleurBSP<S, P, D>(lirePartie<S, P>(chemins[numero]), paire[1], longueur) ;
+                    }
+                    catch (...) {
+                        code = 1 ;
+                    }
+                    ::_exit(code) ;
+                }
+                ::close(paire[1]) ;
+                canaux.push_back(paire[0]) ;
+                processus.push_back(pid) ;
+            }
+
+            std::vector<std::vector<MessageBSP<D>>> boites(k, {{0, depart, D {}}}) ;
+            std::vector<MessageBSP<D>> recus ;
+            bool actif = true ;
+            while (actif) {
+                for (size_t numero = 0; numero < k; ++numero) {
+                    envoyerMessages(canaux[numero], boites[numero]) ;
+                    boites[numero].clear() ;
+                }
+                actif = false ;
+                for (size_t numero = 0; numero < k; ++numero) {
+                    recevoirMessages(canaux[numero], recus) ;
+                    for (const auto& message: recus) {
+                        if (message.partie >= k) throw std::runtime_error("executionRepartie: partie inexistante") ;
+                        boites[message.partie].push_back(message) ;
+                        actif = true ;
+                    }
+                }
+            }
+
+            for (size_t numero = 0; numero < k; ++numero) envoyerOctets(canaux[numero], &FIN_BSP, sizeof(FIN_BSP)) ;
+            for (size_t numero = 0; numero < k; ++numero) {
+                recevoirMessages(canaux[numero], recus) ;
+                for (const auto& message: recus) {
+                    if (message.sommet >= distances.size())
+                        distances.resize(message.sommet + 1, TraitsPoids<D>::infini()) ;
+                    distances[message.sommet] = message.distance ;
+                }
+            }
+        }
+        catch (...) {
+            nettoyer(true) ;
+            throw ;
+        }
+
+        if (!nettoyer(false)) throw std::runtime_error("executionRepartie: un processus de travail a échoué") ;
+        if (depart >= distances.size()) throw std::invalid_argument("executionRepartie: sommet de départ inexistant") ;
+        return distances ;
+    }
+
+}
+
+/**
+ * Parcours en largeur réparti: donne le nombre d'arcs du plus court chemin entre la source et chaque sommet, chaque
+ * partie étant traitée par un processus distinct.  Les sommets inaccessibles restent à std::numeric_limits<size_t>::max().
+ * @param chemins Fichiers des parties, écrits par ecrirePartitions
+ * @param depart Numéro d'origine du sommet source
+ * @return Les distances, dans la numérotation d'origine
+ * @pre Le processus appelant n'a qu'un fil: les parties sont traitées dans des processus créés par fork
+ * @except std::invalid_argument si le sommet de départ n'existe pas
+ * @except std::runtime_error si un processus ou un canal de communication fait défaut, ou si l'appelant a plusieurs fils
+ */
+template <typename S, typename P>
+std::vector<size_t> largeurRepartie(const std::vector<std::string>& chemins, size_t depart) {
+    return executionRepartie<S, P, size_t>(chemins, depart, [](const typename GrapheGenerique<S, P>::Arc&) {
+        return size_t {1} ;
+    }) ;
+}
+
+/**
+ * Plus courts chemins répartis à partir d'une source, pour des poids non négatifs, chaque partie étant traitée par un
+ * processus distinct.
+ * @param chemins Fichiers des parties, écrits par ecrirePartitions
+ * @param depart Numéro d'origine du sommet source
+ * @return Les distances, dans la numérotation d'origine
+ * @pre Le processus appelant n'a qu'un fil: les parties sont traitées dans des processus créés par fork
+ * @except std::invalid_argument si le sommet de départ n'existe pas
+ * @except std::runtime_error si un processus ou un canal de communication fait défaut, ou si l'appelant a plusieurs fils
+ */
+template <typename S, typename P>
+std::vector<P> cheminsRepartis(const std::vector<std::string>& chemins, size_t depart) {
+    return executionRepartie<S, P, P>(chemins, depart, [](const typename GrapheGenerique<S, P>::Arc& arc) {
+        return arc.poids ;
+    }) ;
+}
+
+// Instanciations pour les types de graphes prédéfinis.
+
+#define SIMPLESGRAPHES_INSTANCIER_PARTITIONNEMENT(S, P) \
+    template Partition partitionnerFennel(const GrapheGenerique<S, P>&, size_t, double) ; \
+    template PartieGraphe<S, P> extrairePartie(const GrapheGenerique<S, P>&, const Partition&, size_t) ; \
+    template void ecrirePartie(const PartieGraphe<S, P>&, const std::string&) ; \
+    template PartieGraphe<S, P> lirePartie<S, P>(const std::string&) ; \
+    template std::vector<std::string> ecrirePartitions(const GrapheGenerique<S, P>&, const Partition&, const std::string&) ; \
+    template std::vector<size_t> largeurRepartie<S, P>(const std::vector<std::string>&, size_t) ;
+
+SIMPLESGRAPHES_INSTANCIER_PARTITIONNEMENT(size_t, double)
+SIMPLESGRAPHES_INSTANCIER_PARTITIONNEMENT(uint32_t, float)
+SIMPLESGRAPHES_INSTANCIER_PARTITIONNEMENT(uint32_t, uint32_t)
+SIMPLESGRAPHES_INSTANCIER_PARTITIONNEMENT(uint32_t, SansPoids)
+
+template std::vector<double> cheminsRepartis<size_t, double>(const std::vector<std::string>&, size_t) ;
+template std::vector<float> cheminsRepartis<uint32_t, float>(const std::vector<std::string>&, size_t) ;
+template std::vector<uint32_t> cheminsRepartis<uint32_t, uint32_t>(const std::vector<std::string>&, size_t) ;
@@ -0,0 +1,61 @@
+//
+// Created by Pascal Charpentier on 2023-07-14.
+//
+
+#ifndef SIMPLESGRAPHES_PARTITIONNEMENT_H
+#define SIMPLESGRAPHES_PARTITIONNEMENT_H
+
+#include "Graphe.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * @struct Partition Répartition des sommets d'un graphe en parties.  parties[v] est le numéro de la partie du sommet v;
+ * arcsCoupes compte les arcs dont les deux extrémités sont dans des parties différentes.
+ */
+struct Partition {
+    size_t nombreParties ;
+    std::vector<size_t> parties ;
+    size_t arcsCoupes ;
+};
+
+/**
+ * @struct PartieGraphe Une partie d'un graphe partitionné, autonome: elle peut être écrite sur disque et relue par un
+ * autre processus.  Les sommets locaux portent les numéros 0 à nombreLocaux - 1 et sont suivis des sommets fantômes,
+ * soit les destinations des arcs qui sortent de la partie.  globaux donne le numéro d'origine de chaque sommet local ou
+ * fantôme, proprietaires la partie qui possède chaque fantôme (indicé à partir de nombreLocaux).  Seuls les sommets
+ * locaux ont des arcs sortants.
+ */
+template <typename S, typename P>
+struct PartieGraphe {
+    size_t numero ;
+    size_t nombreLocaux ;
+    std::vector<size_t> globaux ;
+    std::vector<size_t> proprietaires ;
+    GrapheGenerique<S, P> graphe ;
+};
+
+template <typename S, typename P>
+Partition partitionnerFennel(const GrapheGenerique<S, P>& graphe, size_t nombreParties, double desequilibre = 1.1) ;
+
+template <typename S, typename P>
+PartieGraphe<S, P> extrairePartie(const GrapheGenerique<S, P>& graphe, const Partition& partition, size_t numero) ;
+
+template <typename S, typename P>
+void ecrirePartie(const PartieGraphe<S, P>& partie, const std::string& chemin) ;
+
+template <typename S, typename P>
+PartieGraphe<S, P> lirePartie(const std::string& chemin) ;
+
+template <typename S, typename P>
+std::vector<std::string> ecrirePartitions(const GrapheGenerique<S, P>& graphe, const Partition& partition,
+                                          const std::string& prefixe) ;
+
+template <typename S, typename P>
+std::vector<size_t> largeurRepartie(const std::vector<std::string>& chemins, size_t depart) ;
+
+template <typename S, typename P>
+std::vector<P> cheminsRepartis(const std::vector<std::string>& chemins, size_t depart) ;
+
+#endif //SIMPLESGRAPHES_PARTITIONNEMENT_H
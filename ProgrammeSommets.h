@@ -0,0 +1,101 @@
+//
+// Created by Pascal Charpentier on 2023-07-04.
+//
+
+#ifndef SIMPLESGRAPHES_PROGRAMMESOMMETS_H
+#define SIMPLESGRAPHES_PROGRAMMESOMMETS_H
+
+#include "Graphe.h"
+#include "ReservoirFils.h"
+
+#include <vector>
+
+/**
+ * @struct EtatIteratif Résultat d'une exécution de programme de sommets: la valeur finale de chaque sommet, le nombre
+ * d'itérations effectuées et si la convergence a été atteinte avant la limite d'itérations.
+ */
+template <typename V>
+struct EtatIteratif {
+    std::vector<V> valeurs ;
+    size_t iterations ;
+    bool converge ;
+};
+
+/**
+ * Moteur générique de calcul itératif centré sur les sommets, en mode « pull »: à chaque itération, chaque sommet actif
+ * recalcule sa valeur à partir des valeurs de ses prédécesseurs, lues dans la liste d'adjacence du graphe inverse.  Les
+ * nouvelles valeurs ne sont visibles qu'à l'itération suivante (mise à jour de Jacobi); chaque sommet n'écrit que sa
+ * propre valeur, de sorte qu'une itération se répartit entre les fils du réservoir sans verrou.
+ *
+ * Un sommet dont la valeur n'a pas changé significativement devient inactif et n'est plus recalculé, sauf si l'un de
+ * ses prédécesseurs change à son tour.  L'exécution se termine lorsqu'il n'y a plus de sommet actif.
+ *
+ * Le programme doit fournir:
+ *
+ * Valeur: le type des valeurs associées aux sommets.
+ * Valeur initiale(size_t sommet) const: la valeur de départ d'un sommet.
+ * bool preparer(const std::vector<Valeur>& valeurs): appelée seule au début de chaque itération, pour calculer les
+ * termes globaux (par exemple une somme sur tous les sommets).  Retourne true si ces termes ont changé au point où tous
+ * les sommets doivent être recalculés.
+ * Valeur calculer(size_t sommet, const Liste& entrants, const std::vector<Valeur>& valeurs) const: la nouvelle
+ * valeur du sommet; entrants, la liste d'arcs du graphe inverse, contient un arc vers chacun de ses prédécesseurs.
+ * Appelée en parallèle.
+ * bool change(const Valeur& ancienne, const Valeur& nouvelle) const: true si la différence dépasse la tolérance.
+ *
+ * @param graphe Graphe parcouru: GrapheGenerique ou GrapheCompresse
+ * @param programme Le programme de sommets
+ * @param iterationsMax Nombre maximal d'itérations
+ * @param reservoir Réservoir de fils
+ * @return Les valeurs finales et l'état de la convergence
+ */
+template <typename G, typename Programme>
+EtatIteratif<typename Programme::Valeur> executerProgrammeSommets(const G& graphe, Programme& programme,
+                                                                  size_t iterationsMax, ReservoirFils& reservoir) {
+    using Valeur = typename Programme::Valeur ;
+    const size_t n = graphe.taille() ;
+    const G inverse = graphe.grapheInverse() ;
+
+    EtatIteratif<Valeur> etat {std::vector<Valeur>(), 0, false} ;
+    etat.valeurs.reserve(n) ;
+    for (size_t sommet = 0; sommet < n; ++sommet) etat.valeurs.push_back(programme.initiale(sommet)) ;
+
+    std::vector<Valeur> nouvelles(etat.valeurs) ;
+    std::vector<char> actifs(n, 1), changes(n, 0) ;
+    std::vector<size_t> listeActifs(n) ;
+    for (size_t sommet = 0; sommet < n; ++sommet) listeActifs[sommet] = sommet ;
+
+    while (etat.iterations < iterationsMax) {
+        if (programme.preparer(etat.valeurs) && listeActifs.size() != n) {
+            listeActifs.resize(n) ;
+            for (size_t sommet = 0; sommet < n; ++sommet) listeActifs[sommet] = sommet ;
+        }
+        if (listeActifs.empty()) break ;
+        ++ etat.iterations ;
+
+        reservoir.repartir(listeActifs.size(), [&](size_t debut, size_t fin, size_t) {
+            for (size_t i = debut; i < fin; ++i) {
+                size_t sommet = listeActifs[i] ;
+                nouvelles[sommet] = programme.calculer(sommet, inverse.enumererVoisins(sommet), etat.valeurs) ;
+                changes[sommet] = programme.change(etat.valeurs[sommet], nouvelles[sommet]) ;
+            }
+        }, 256) ;
+
+        for (auto sommet: listeActifs) actifs[sommet] = 0 ;
+        std::vector<size_t> prochains ;
+        for (auto sommet: listeActifs) {
+            etat.valeurs[sommet] = nouvelles[sommet] ;
+            if (!changes[sommet]) continue ;
+            for (const auto& arc: graphe.enumererVoisins(sommet))
+                if (!actifs[arc.destination]) {
+                    actifs[arc.destination] = 1 ;
+                    prochains.push_back(arc.destination) ;
+                }
+        }
+        listeActifs.swap(prochains) ;
+    }
+
+    etat.converge = listeActifs.empty() ;
+    return etat ;
+}
+
+#endif //SIMPLESGRAPHES_PROGRAMMESOMMETS_H
@@ -0,0 +1,169 @@
+//
+// Created by Pascal Charpentier on 2023-06-22.
+//
+
+#ifndef SIMPLESGRAPHES_RELAXATIONBLOC_H
+#define SIMPLESGRAPHES_RELAXATIONBLOC_H
+
+#include "Graphe.h"
+
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @struct BlocRelaxation
+ *
+ * Tampon servant à relaxer les voisins d'un sommet par blocs.  Les arcs de la liste d'adjacence sont recopiés dans des
+ * tableaux contigus (destinations et poids), ce qui permet de calculer toutes les distances candidates du bloc d'un
+ * seul coup, avec des instructions vectorielles lorsque le compilateur les permet (AVX-512 ou AVX2, voir l'option
+ * SIMPLESGRAPHES_NATIVE dans CMakeLists.txt).  Sinon, une boucle scalaire est utilisée.
+ *
+ * @tparam S Type des numéros de sommets
+ * @tparam P Type de pondération
+ */
+template <typename S, typename P>
+struct BlocRelaxation {
+    static constexpr size_t capacite = 64 ;
+
+    S destinations[capacite] ;
+    P poids[capacite] ;
+    P candidats[capacite] ;
+    bool ameliore[capacite] ;
+    size_t taille ;
+};
+
+/**
+ * Calcule les distances candidates d'un bloc: candidat[i] = distanceCourante + poids[i], et note celles qui améliorent
+ * la distance connue de leur destination.  Version scalaire, utilisée pour tous les types sans version vectorielle.
+ * @param distanceCourante Distance du sommet dont on relaxe les voisins
+ * @param distances Distances connues, indexées par numéro de sommet
+ * @param bloc Bloc à traiter; les champs candidats et ameliore sont remplis
+ * @param debut Premier élément du bloc à traiter
+ */
+template <typename S, typename P>
+void calculerCandidatsScalaire(P distanceCourante, const P* distances, BlocRelaxation<S, P>& bloc, size_t debut) {
+    for (size_t i = debut; i < bloc.taille; ++i) {
+        bloc.candidats[i] = distanceCourante + bloc.poids[i] ;
+        bloc.ameliore[i] = bloc.candidats[i] < distances[bloc.destinations[i]] ;
+    }
+}
+
+template <typename S, typename P>
+void calculerCandidats(P distanceCourante, const P* distances, BlocRelaxation<S, P>& bloc) {
+    calculerCandidatsScalaire(distanceCourante, distances, bloc, 0) ;
+}
+
+/**
+ * Version vectorielle pour Graphe (sommets size_t, poids double): les distances des destinations sont rassemblées
+ * (gather) par groupes de 8 ou de 4, additionnées et comparées en un seul passage.
+ */
+inline void calculerCandidats(double distanceCourante, const double* distances, BlocRelaxation<size_t, double>& bloc) {
+    size_t i = 0 ;
+#if defined(__AVX512F__)
+    const __m512d courante = _mm512_set1_pd(distanceCourante) ;
+    for (; i + 8 <= bloc.taille; i += 8) {
+        __m512i index = _mm512_loadu_si512(bloc.destinations + i) ;
+        __m512d connues = _mm512_i64gather_pd(index, distances, 8) ;
+        __m512d candidats = _mm512_add_pd(courante, _mm512_loadu_pd(bloc.poids + i)) ;
+        __mmask8 masque = _mm512_cmp_pd_mask(candidats, connues, _CMP_LT_OQ) ;
+        _mm512_storeu_pd(bloc.candidats + i, candidats) ;
+        for (size_t j = 0; j < 8; ++j) bloc.ameliore[i + j] = (masque >> j) & 1 ;
+    }
+#elif defined(__AVX2__)
+    const __m256d courante = _mm256_set1_pd(distanceCourante) ;
+    for (; i + 4 <= bloc.taille; i += 4) {
+        __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bloc.destinations + i)) ;
+        __m256d connues = _mm256_i64gather_pd(distances, index, 8) ;
+        __m256d candidats = _mm256_add_pd(courante, _mm256_loadu_pd(bloc.poids + i)) ;
+        int masque = _mm256_movemask_pd(_mm256_cmp_pd(candidats, connues, _CMP_LT_OQ)) ;
+        _mm256_storeu_pd(bloc.candidats + i, candidats) ;
+        for (size_t j = 0; j < 4; ++j) bloc.ameliore[i + j] = (masque >> j) & 1 ;
+    }
+#endif
+    calculerCandidatsScalaire(distanceCourante, distances, bloc, i) ;
+}
+
+/**
+ * Version vectorielle pour GrapheCompact (sommets uint32_t, poids float), par groupes de 16 ou de 8.  Les numéros de
+ * sommets vont jusqu'à 2^32 - 1: ils sont étendus à 64 bits sans signe avant le gather, par demi-groupes, pour ne
+ * jamais devenir des décalages négatifs.
+ */
+inline void calculerCandidats(float distanceCourante, const float* distances, BlocRelaxation<uint32_t, float>& bloc) {
+    size_t i = 0 ;
+#if defined(__AVX512F__)
+    const __m512 courante = _mm512_set1_ps(distanceCourante) ;
+    for (; i + 16 <= bloc.taille; i += 16) {
+        const auto* groupe = reinterpret_cast<const __m256i*>(bloc.destinations + i) ;
+        __m512i bas = _mm512_cvtepu32_epi64(_mm256_loadu_si256(groupe)) ;
+        __m512i haut = _mm512_cvtepu32_epi64(_mm256_loadu_si256(groupe + 1)) ;
+        __m512 connues = _mm512_castpd_ps(_mm512_insertf64x4(
+            _mm512_castps_pd(_mm512_castps256_ps512(_mm512_i64gather_ps(bas, distances, 4))),
+            _mm256_castps_pd(_mm512_i64gather_ps(haut, distances, 4)), 1)) ;
+        __m512 candidats = _mm512_add_ps(courante, _mm512_loadu_ps(bloc.poids + i)) ;
+        __mmask16 masque = _mm512_cmp_ps_mask(candidats, connues, _CMP_LT_OQ) ;
+        _mm512_storeu_ps(bloc.candidats + i, candidats) ;
+        for (size_t j = 0; j < 16; ++j) bloc.ameliore[i + j] = (masque >> j) & 1 ;
+    }
+#elif defined(__AVX2__)
+    const __m256 courante = _mm256_set1_ps(distanceCourante) ;
+    for (; i + 8 <= bloc.taille; i += 8) {
+        const auto* groupe = reinterpret_cast<const __m128i*>(bloc.destinations + i) ;
+        __m256i bas = _mm256_cvtepu32_epi64(_mm_loadu_si128(groupe)) ;
+        __m256i haut = _mm256_cvtepu32_epi64(_mm_loadu_si128(groupe + 1)) ;
+        __m256 connues = _mm256_set_m128(_mm256_i64gather_ps(distances, haut, 4),
+                                         _mm256_i64gather_ps(distances, bas, 4)) ;
+        __m256 candidats = _mm256_add_ps(courante, _mm256_loadu_ps(bloc.poids + i)) ;
+        int masque = _mm256_movemask_ps(_mm256_cmp_ps(candidats, connues, _CMP_LT_OQ)) ;
+        _mm256_storeu_ps(bloc.candidats + i, candidats) ;
+        for (size_t j = 0; j < 8; ++j) bloc.ameliore[i + j] = (masque >> j) & 1 ;
+    }
+#endif
+    calculerCandidatsScalaire(distanceCourante, distances, bloc, i) ;
+}
+
+/**
+ * Relaxe tous les arcs partant d'un sommet, bloc par bloc.  Seules les destinations dont la distance est améliorée sont
+ * transmises à l'action, qui se charge de mettre à jour les distances, les prédécesseurs et, au besoin, la file
+ * prioritaire.  Comme un sommet n'a jamais deux arcs vers la même destination, les éléments d'un même bloc sont
+ * indépendants.
+ * @param graphe Graphe parcouru
+ * @param courant Numéro du sommet dont on relaxe les arcs
+ * @param distances Distances connues; lues ici, modifiées seulement par l'action
+ * @param action Appelée comme action(destination, nouvelleDistance) pour chaque amélioration
+ * @return Le nombre de distances améliorées
+ * @pre courant est un sommet du graphe et distances contient graphe.taille() éléments
+ */
+template <typename S, typename P, typename Action>
+size_t relaxerVoisins(const GrapheGenerique<S, P>& graphe, size_t courant, const std::vector<P>& distances,
+                      Action&& action) {
+    const P distanceCourante = distances[courant] ;
+    if (distanceCourante == TraitsPoids<P>::infini()) return 0 ;
+
+    const auto& liste = graphe.enumererVoisins(courant) ;
+    BlocRelaxation<S, P> bloc ;
+    size_t ameliorations = 0 ;
+
+    auto it = liste.begin() ;
+    while (it != liste.end()) {
+        bloc.taille = 0 ;
+        for (; it != liste.end() && bloc.taille < BlocRelaxation<S, P>::capacite; ++it, ++bloc.taille) {
+            bloc.destinations[bloc.taille] = it->destination ;
+            bloc.poids[bloc.taille] = it->poids ;
+        }
+
+        calculerCandidats(distanceCourante, distances.data(), bloc) ;
+
+        for (size_t i = 0; i < bloc.taille; ++i)
+            if (bloc.ameliore[i]) {
+                action(static_cast<size_t>(bloc.destinations[i]), bloc.candidats[i]) ;
+                ++ ameliorations ;
+            }
+    }
+    return ameliorations ;
+}
+
+#endif //SIMPLESGRAPHES_RELAXATIONBLOC_H
@@ -0,0 +1,124 @@
+//
+// Created by Pascal Charpentier on 2023-06-26.
+//
+
+#include "ReservoirFils.h"
+
+#include <algorithm>
+
+/**
+ * Construit un réservoir et démarre ses fils.
+ * @param nombreFils Nombre total de fils, en comptant le fil appelant.  La valeur 0 utilise le nombre de coeurs de la
+ * machine.
+ */
+ReservoirFils::ReservoirFils(size_t nombreFils) : fils(), tache(nullptr), nombre(0), tailleTranche(1), prochain(0),
+                                                  actifs(0), generation(0), arret(false), erreur() {
+    if (nombreFils == 0) nombreFils = std::max(1u, std::thread::hardware_concurrency()) ;
+
+    for (size_t i = 1; i < nombreFils; ++i) fils.emplace_back(&ReservoirFils::boucleTravailleur, this, i) ;
+}
+
+/**
+ * Arrête les fils et attend qu'ils aient terminé.
+ */
+ReservoirFils::~ReservoirFils() {
+    {
+        std::lock_guard<std::mutex> garde(verrou) ;
+        arret = true ;
+    }
+    reveil.notify_all() ;
+    for (auto& fil: fils) fil.join() ;
+}
+
+/**
+ * @return Le nombre de fils qui participent à chaque répartition, fil appelant compris.
+ */
+size_t ReservoirFils::taille() const {
+    return fils.size() + 1 ;
+}
+
+/**
+ * Exécute une tâche sur l'intervalle [0, nombre), découpé en tranches distribuées dynamiquement entre les fils.  La
+ * fonction ne retourne que lorsque toutes les tranches ont été traitées.
+ * @param nombre Taille de l'intervalle à traiter
+ * @param tache Appelée comme tache(debut, fin, fil) pour chaque tranche [debut, fin)
+ * @param grain Taille minimale d'une tranche.  Un intervalle plus petit est traité directement par le fil appelant.
+ * @except Relance la première exception levée par une tranche, une fois toutes les tranches terminées.
+ */
+void ReservoirFils::repartir(size_t nombre, const Tache& tache, size_t grain) {
+    if (nombre == 0) return ;
+    if (fils.empty() || nombre <= grain) {
+        tache(0, nombre, 0) ;
+        return ;
+    }
+
+    std::lock_guard<std::mutex> tour(serialisation) ;
+    {
+        std::lock_guard<std::mutex> garde(verrou) ;
+        this->tache = &tache ;
+        this->nombre = nombre ;
+        tailleTranche = std::max(grain, nombre / (4 * taille()) + 1) ;
+        prochain = 0 ;
+        actifs = fils.size() ;
+        erreur = nullptr ;
+        ++ generation ;
+    }
+    reveil.notify_all() ;
+
+    executerTranches(0) ;
+
+    std::unique_lock<std::mutex> garde(verrou) ;
+    termine.wait(garde, [this] {return actifs == 0 ; }) ;
+    this->tache = nullptr ;
+    if (erreur) std::rethrow_exception(erreur) ;
+}
+
+/**
+ * Boucle principale d'un fil du réservoir: attend une nouvelle répartition, y participe, puis signale sa fin.
+ * @param fil Numéro du fil, entre 1 et taille() - 1
+ */
+void ReservoirFils::boucleTravailleur(size_t fil) {
+    size_t vue = 0 ;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> garde(verrou) ;
+            reveil.wait(garde, [this, vue] {return arret || generation != vue ; }) ;
+            if (arret) return ;
+            vue = generation ;
+        }
+
+        executerTranches(fil) ;
+
+        std::lock_guard<std::mutex> garde(verrou) ;
+        if (-- actifs == 0) termine.notify_one() ;
+    }
+}
+
+/**
+ * Réclame des tranches jusqu'à épuisement de l'intervalle.  Les exceptions sont conservées pour le fil appelant.
+ * @param fil Numéro du fil qui exécute les tranches
+ */
+void ReservoirFils::executerTranches(size_t fil) {
+    while (true) {
+        size_t debut = prochain.fetch_add(tailleTranche) ;
+        if (debut >= nombre) return ;
+        size_t fin = std::min(nombre, debut + tailleTranche) ;
+        try {
+            (*tache)(debut, fin, fil) ;
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> garde(verrou) ;
+            if (!erreur) erreur = std::current_exception() ;
+        }
+    }
+}
+
+/**
+ * Réservoir partagé utilisé par défaut par les algorithmes parallèles.  Il est créé au premier usage et compte autant
+ * de fils que la machine a de coeurs.
+ * @return Le réservoir par défaut
+ */
+ReservoirFils& ReservoirFils::parDefaut() {
+    static ReservoirFils reservoir ;
+    return reservoir ;
+}
@@ -0,0 +1,67 @@
+//
+// Created by Pascal Charpentier on 2023-06-26.
+//
+
+#ifndef SIMPLESGRAPHES_RESERVOIRFILS_H
+#define SIMPLESGRAPHES_RESERVOIRFILS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ReservoirFils
+ *
+ * Réservoir de fils d'exécution servant aux versions parallèles des algorithmes.  Les fils sont créés une seule fois, à
+ * la construction, puis réutilisés par chaque appel à repartir, qui distribue un intervalle [0, nombre) en tranches.
+ * Le fil appelant participe lui aussi au travail et porte le numéro 0; les autres sont numérotés de 1 à taille() - 1,
+ * ce qui permet aux algorithmes de tenir des accumulateurs par fil.
+ *
+ * Les appels concurrents à repartir sur un même réservoir sont exécutés l'un après l'autre.  ATTENTION: une tâche ne
+ * doit jamais appeler repartir sur le réservoir qui l'exécute.
+ */
+class ReservoirFils {
+public:
+    using Tache = std::function<void(size_t debut, size_t fin, size_t fil)> ;
+
+    explicit ReservoirFils(size_t nombreFils = 0) ;
+
+    ~ReservoirFils() ;
+
+    ReservoirFils(const ReservoirFils&) = delete ;
+    ReservoirFils& operator = (const ReservoirFils&) = delete ;
+
+    size_t taille()                                               const ;
+
+    void   repartir(size_t nombre, const Tache& tache, size_t grain = 1) ;
+
+    static ReservoirFils& parDefaut() ;
+
+private:
+    void   boucleTravailleur(size_t fil) ;
+
+    void   executerTranches(size_t fil) ;
+
+    std::vector<std::thread> fils ;
+
+    std::mutex               serialisation ;
+    std::mutex               verrou ;
+    std::condition_variable  reveil ;
+    std::condition_variable  termine ;
+
+    const Tache*             tache ;
+    size_t                   nombre ;
+    size_t                   tailleTranche ;
+    std::atomic<size_t>      prochain ;
+    size_t                   actifs ;
+    size_t                   generation ;
+    bool                     arret ;
+    std::exception_ptr       erreur ;
+};
+
+#endif //SIMPLESGRAPHES_RESERVOIRFILS_H
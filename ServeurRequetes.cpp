@@ -0,0 +1,593 @@
+//
+// Created by Pascal Charpentier on 2023-07-19.
+//
+
+#include "ServeurRequetes.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * Charge un graphe écrit en texte: le nombre de sommets, puis un arc par ligne, « depart arrivee [poids] », le poids
+ * valant 1 par défaut.  Les lignes vides et celles qui commencent par # sont ignorées.  Le poids doit être un nombre
+ * fini positif ou nul, puisque les plus courts chemins du serveur le supposent.
+ * @param chemin Chemin du fichier
+ * @return Le graphe
+ * @except std::runtime_error si le fichier ne peut être ouvert
+ * @except std::invalid_argument si une ligne est mal formée (champ non numérique, poids négatif, champ en trop) ou
+ * désigne un sommet inexistant
+ */
+Graphe chargerGraphe(const std::string& chemin) {
+    std::ifstream fichier(chemin) ;
+    if (!fichier) throw std::runtime_error("chargerGraphe: impossible d'ouvrir " + chemin) ;
+
+    Graphe graphe ;
+    bool tailleLue = false ;
+    std::string ligne ;
+    for (size_t numero = 1; std::getline(fichier, ligne); ++numero) {
+        std::istringstream flux(ligne) ;
+        std::vector<std::string> champs ;
+        for (std::string champ; flux >> champ; ) champs.push_back(champ) ;
+        if (champs.empty() || champs[0][0] == '#') continue ;
+
+        const std::string malFormee = "chargerGraphe: ligne " + std::to_string(numero) + " mal formée" ;
+        auto lireEntier = [&](const std::string& champ) {
+            std::istringstream lecture(champ) ;
+            size_t valeur ;
+            if (champ[0] == '-' || !(lecture >> valeur) || !lecture.eof()) throw std::invalid_argument(malFormee) ;
+            return valeur ;
+        } ;
+
+        if (!tailleLue) {
+            if (champs.size() != 1) throw std::invalid_argument(malFormee) ;
+            graphe = Graphe(lireEntier(champs[0])) ;
+            tailleLue = true ;
+            continue ;
+        }
+        if (champs.size() < 2 || champs.size() > 3) throw std::invalid_argument(malFormee) ;
+        size_t depart = lireEntier(champs[0]), arrivee = lireEntier(champs[1]) ;
+        double poids = 1.0 ;
+        if (champs.size() == 3) {
+            std::istringstream lecture(champs[2]) ;
+            if (!(lecture >> poids) || !lecture.eof() || !std::isfinite(poids) || poids < 0)
+                throw std::invalid_argument(malFormee) ;
+        }
+        if (!graphe.sommetExiste(depart) || !graphe.sommetExiste(arrivee))
+            throw std::invalid_argument("chargerGraphe: ligne " + std::to_string(numero) + ": sommet inexistant") ;
+        graphe.ajouterArc(depart, arrivee, poids) ;
+    }
+    return graphe ;
+}
+
+/**
+ * Enregistre une durée.
+ * @param duree La latence mesurée
+ */
+void HistogrammeLatences::enregistrer(std::chrono::nanoseconds duree) {
+    auto microsecondes = static_cast<uint64_t>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::microseconds>(duree).count())) ;
+    size_t classe = 0 ;
+    while (classe + 1 < NOMBRE_CLASSES && (microsecondes >> classe) != 0) ++ classe ;
+    classes[classe].fetch_add(1, std::memory_order_relaxed) ;
+
+    uint64_t ancien = plusLongue.load(std::memory_order_relaxed) ;
+    while (microsecondes > ancien && !plusLongue.compare_exchange_weak(ancien, microsecondes, std::memory_order_relaxed)) ;
+}
+
+/**
+ * @return Le nombre de durées enregistrées
+ */
+uint64_t HistogrammeLatences::nombre() const {
+    uint64_t total = 0 ;
+    for (const auto& classe: classes) total += classe.load(std::memory_order_relaxed) ;
+    return total ;
+}
+
+/**
+ * Estime un quantile par la borne supérieure de la classe qui le contient.
+ * @param proportion Entre 0 et 1, par exemple 0.99 pour le 99e centile
+ * @return Le quantile, en microsecondes; 0 si rien n'a été enregistré
+ */
+uint64_t HistogrammeLatences::quantile(double proportion) const {
+    uint64_t total = nombre() ;
+    if (total == 0) return 0 ;
+    auto rang = static_cast<uint64_t>(std::ceil(proportion * static_cast<double>(total))) ;
+    uint64_t cumul = 0 ;
+    for (size_t classe = 0; classe < NOMBRE_CLASSES; ++classe) {
+        cumul += classes[classe].load(std::memory_order_relaxed) ;
+        if (cumul >= std::max<uint64_t>(rang, 1)) return std::min(uint64_t {1} << classe, maximum()) ;
+    }
+    return maximum() ;
+}
+
+/**
+ * @return La plus longue durée enregistrée, en microsecondes
+ */
+uint64_t HistogrammeLatences::maximum() const {
+    return plusLongue.load(std::memory_order_relaxed) ;
+}
+
+/**
+ * @return Un résumé d'une ligne: nombre de requêtes, médiane, 90e et 99e centiles et maximum, en microsecondes
+ */
+std::string HistogrammeLatences::rapport() const {
+    std::ostringstream flux ;
+    flux << "n=" << nombre() << " p50=" << quantile(0.5) << "us p90=" << quantile(0.9) << "us p99=" << quantile(0.99)
+         << "us max=" << maximum() << "us" ;
+    return flux.str() ;
+}
+
+/**
+ * @struct ServeurRequetes::Connexion Une connexion cliente: les octets reçus qui ne forment pas encore une ligne, les
+ * requêtes en attente avec leur heure de réception, les réponses pas encore acceptées par la socket, si une requête
+ * est en cours de traitement, si le client a fermé son sens d'écriture (la connexion est alors vidée de ses requêtes
+ * et de ses réponses avant d'être fermée) et si la connexion est rompue.  Seul le fil d'écoute touche au tampon de
+ * réception; le reste est protégé par le verrou.  La socket est fermée à la destruction, une fois que ni le fil d'écoute ni les
+ * fils de travail n'y font plus référence.
+ */
+struct ServeurRequetes::Connexion {
+    int                                                        canal ;
+    std::string                                                tampon ;
+    std::mutex                                                 verrou ;
+    std::deque<std::pair<std::string, Horloge::time_point>>   enAttente ;
+    std::string                                                sortie ;
+    bool                                                       occupee ;
+    bool                                                       terminee ;
+    bool                                                       rompue ;
+
+    explicit Connexion(int canal)
+        : canal(canal), tampon(), verrou(), enAttente(), sortie(), occupee(false), terminee(false), rompue(false) {}
+    ~Connexion() {::close(canal) ; }
+
+    /**
+     * Envoie sans bloquer le plus possible du tampon de sortie.  Le verrou doit être tenu.
+     * @return false si la socket est rompue
+     */
+    bool envoyer() {
+        size_t envoyes = 0 ;
+        while (envoyes < sortie.size()) {
+            ssize_t n = ::send(canal, sortie.data() + envoyes, sortie.size() - envoyes, MSG_NOSIGNAL | MSG_DONTWAIT) ;
+            if (n < 0 && errno == EINTR) continue ;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break ;
+            if (n <= 0) return false ;
+            envoyes += static_cast<size_t>(n) ;
+        }
+        sortie.erase(0, envoyes) ;
+        return true ;
+    }
+};
+
+namespace {
+
+    /**
+     * Rend un descripteur non bloquant.
+     * @return false si fcntl a échoué
+     */
+    bool rendreNonBloquant(int descripteur) {
+        int drapeaux = ::fcntl(descripteur, F_GETFL) ;
+        return drapeaux >= 0 && ::fcntl(descripteur, F_SETFL, drapeaux | O_NONBLOCK) == 0 ;
+    }
+}
+
+/**
+ * Prépare le serveur: calcule les composantes fortement connexes et démarre les fils de travail.
+ * @param graphe Le graphe servi, qui doit survivre au serveur et ne plus être modifié
+ * @param nombreFils Nombre de fils de travail; 0 pour le nombre de coeurs de la machine
+ * @except std::runtime_error si le tube d'arrêt ou le tube de sortie ne peut être créé
+ */
+ServeurRequetes::ServeurRequetes(const Graphe& graphe, size_t nombreFils)
+    : graphe(graphe), composantes(graphe.taille()), taillesComposantes(graphe.taille(), 0), espaces(), latences(),
+      fils(), verrou(), reveil(), pretes(), fin(false), autoTube {-1, -1}, tubeSortie {-1, -1},
+      arrete(false) {
+    for (const auto& composante: kosaraju(graphe))
+        for (auto sommet: composante) {
+            composantes[sommet] = *composante.begin() ;
+            taillesComposantes[sommet] = composante.size() ;
+        }
+
+    if (::pipe(autoTube) != 0) throw std::runtime_error("ServeurRequetes: impossible de créer le tube d'arrêt") ;
+    if (::pipe(tubeSortie) != 0 || !rendreNonBloquant(tubeSortie[0]) || !rendreNonBloquant(tubeSortie[1])) {
+        ::close(autoTube[0]) ;
+        ::close(autoTube[1]) ;
+        throw std::runtime_error("ServeurRequetes: impossible de créer le tube de sortie") ;
+    }
+
+    if (nombreFils == 0) nombreFils = std::max(1u, std::thread::hardware_concurrency()) ;
+    espaces.resize(nombreFils) ;
+    for (size_t fil = 0; fil < nombreFils; ++fil) fils.emplace_back(&ServeurRequetes::boucleTravailleur, this, fil) ;
+}
+
+/**
+ * Arrête les fils de travail.  Les requêtes encore en file ne sont pas traitées.
+ */
+ServeurRequetes::~ServeurRequetes() {
+    {
+        std::lock_guard<std::mutex> garde(verrou) ;
+        fin = true ;
+    }
+    reveil.notify_all() ;
+    for (auto& fil: fils) fil.join() ;
+    ::close(autoTube[0]) ;
+    ::close(autoTube[1]) ;
+    ::close(tubeSortie[0]) ;
+    ::close(tubeSortie[1]) ;
+}
+
+/**
+ * @return Le nombre de fils de travail, soit le nombre d'espaces de travail utilisables par traiter
+ */
+size_t ServeurRequetes::nombreFils() const {
+    return espaces.size() ;
+}
+
+/**
+ * Traite une requête, sans passer par le réseau.
+ * @param requete Une ligne de requête, sans fin de ligne
+ * @param fil Numéro de l'espace de travail à utiliser, entre 0 et nombreFils() - 1.  Deux appels simultanés ne doivent
+ * jamais utiliser le même espace, qui est aussi celui d'un fil de travail: on ne l'appelle donc qu'en l'absence de
+ * trafic réseau.
+ * @return La réponse, sans fin de ligne
+ */
+std::string ServeurRequetes::traiter(const std::string& requete, size_t fil) {
+    if (fil >= espaces.size()) throw std::invalid_argument("ServeurRequetes::traiter: fil inexistant") ;
+    return executer(requete, fil, Horloge::now()) ;
+}
+
+/**
+ * Exécute une requête et enregistre sa latence depuis sa réception.  Les erreurs sont rapportées au client, jamais
+ * propagées.
+ */
+std::string ServeurRequetes::executer(const std::string& requete, size_t fil, Horloge::time_point reception) {
+    std::istringstream flux(requete) ;
+    std::string commande ;
+    flux >> commande ;
+    std::transform(commande.begin(), commande.end(), commande.begin(), [](unsigned char c) {
+        return static_cast<char>(std::toupper(c)) ;
+    }) ;
+
+    TypeRequete type = AUTRE ;
+    std::ostringstream reponse ;
+    try {
+        auto lireSommet = [&]() {
+            long long sommet = -1 ;
+            if (!(flux >> sommet) || sommet < 0 || !graphe.sommetExiste(static_cast<size_t>(sommet)))
+                throw std::invalid_argument("sommet invalide") ;
+            return static_cast<size_t>(sommet) ;
+        } ;
+        auto verifierFin = [&]() {
+            if (!(flux >> std::ws).eof()) throw std::invalid_argument("argument en trop") ;
+        } ;
+        auto& espace = espaces[fil] ;
+
+        if (commande == "CHEMIN") {
+            type = CHEMIN ;
+            size_t depart = lireSommet() ;
+            size_t arrivee = lireSommet() ;
+            verifierFin() ;
+            double distance = cheminPlusCourt(graphe, depart, arrivee, espace.distances, espace.chemin) ;
+            if (espace.chemin.empty()) reponse << "OK inf 0" ;
+            else {
+                reponse << "OK " << distance << ' ' << espace.chemin.size() ;
+                for (auto sommet: espace.chemin) reponse << ' ' << sommet ;
+            }
+        }
+        else if (commande == "BFS") {
+            type = BFS ;
+            size_t depart = lireSommet() ;
+            long long sautsMax = -1 ;
+            if (!(flux >> std::ws).eof() && !(flux >> sautsMax)) throw std::invalid_argument("limite de sauts invalide") ;
+            verifierFin() ;
+            size_t limite = sautsMax < 0 ? std::numeric_limits<size_t>::max() : static_cast<size_t>(sautsMax) ;
+            const auto& atteints = voisinageSauts(graphe, depart, limite, espace.sauts) ;
+            reponse << "OK " << atteints.size() ;
+            for (const auto& atteint: atteints) reponse << ' ' << atteint.sommet << ':' << atteint.distance ;
+        }
+        else if (commande == "CFC") {
+            type = CFC ;
+            size_t sommet = lireSommet() ;
+            verifierFin() ;
+            reponse << "OK " << composantes[sommet] << ' ' << taillesComposantes[sommet] ;
+        }
+        else if (commande == "STATS") {
+            verifierFin() ;
+            reponse << "OK " << statistiques() ;
+        }
+        else throw std::invalid_argument("requête inconnue") ;
+    }
+    catch (const std::exception& e) {
+        reponse.str("") ;
+        reponse << "ERREUR " << e.what() ;
+    }
+
+    latences[type].enregistrer(Horloge::now() - reception) ;
+    return reponse.str() ;
+}
+
+/**
+ * @return Le rapport des histogrammes de latence, par type de requête, sur une ligne
+ */
+std::string ServeurRequetes::statistiques() const {
+    return "CHEMIN " + latences[CHEMIN].rapport() + "; BFS " + latences[BFS].rapport() + "; CFC "
+           + latences[CFC].rapport() + "; AUTRE " + latences[AUTRE].rapport() ;
+}
+
+/**
+ * Écoute sur une socket Unix jusqu'à l'appel d'arreter.  Un fichier déjà présent au même chemin est remplacé, puis
+ * supprimé à la fin.
+ * @param chemin Chemin de la socket
+ * @except std::runtime_error si la socket ne peut être créée
+ */
+void ServeurRequetes::ecouterUnix(const std::string& chemin) {
+    sockaddr_un adresse {} ;
+    adresse.sun_family = AF_UNIX ;
+    if (chemin.size() >= sizeof(adresse.sun_path)) throw std::runtime_error("ServeurRequetes::ecouterUnix: chemin trop long") ;
+    std::strcpy(adresse.sun_path, chemin.c_str()) ;
+
+    int ecoute = ::socket(AF_UNIX, SOCK_STREAM, 0) ;
+    if (ecoute < 0) throw std::runtime_error("ServeurRequetes::ecouterUnix: socket a échoué") ;
+    ::unlink(chemin.c_str()) ;
+    if (::bind(ecoute, reinterpret_cast<sockaddr*>(&adresse), sizeof(adresse)) != 0 || ::listen(ecoute, 128) != 0) {
+        ::close(ecoute) ;
+        throw std::runtime_error("ServeurRequetes::ecouterUnix: impossible d'écouter sur " + chemin) ;
+    }
+
+    try {
+        servir(ecoute) ;
+    }
+    catch (...) {
+        ::close(ecoute) ;
+        ::unlink(chemin.c_str()) ;
+        throw ;
+    }
+    ::close(ecoute) ;
+    ::unlink(chemin.c_str()) ;
+}
+
+/**
+ * Écoute en TCP sur l'interface locale (127.0.0.1) jusqu'à l'appel d'arreter.
+ * @param port Numéro de port
+ * @except std::runtime_error si la socket ne peut être créée
+ */
+void ServeurRequetes::ecouterTcp(uint16_t port) {
+    int ecoute = ::socket(AF_INET, SOCK_STREAM, 0) ;
+    if (ecoute < 0) throw std::runtime_error("ServeurRequetes::ecouterTcp: socket a échoué") ;
+    int oui = 1 ;
+    ::setsockopt(ecoute, SOL_SOCKET, SO_REUSEADDR, &oui, sizeof(oui)) ;
+
+    sockaddr_in adresse {} ;
+    adresse.sin_family = AF_INET ;
+    adresse.sin_port = htons(port) ;
+    adresse.sin_addr.s_addr = htonl(INADDR_LOOPBACK) ;
+    if (::bind(ecoute, reinterpret_cast<sockaddr*>(&adresse), sizeof(adresse)) != 0 || ::listen(ecoute, 128) != 0) {
+        ::close(ecoute) ;
+        throw std::runtime_error("ServeurRequetes::ecouterTcp: impossible d'écouter sur le port " + std::to_string(port)) ;
+    }
+
+    try {
+        servir(ecoute) ;
+    }
+    catch (...) {
+        ::close(ecoute) ;
+        throw ;
+    }
+    ::close(ecoute) ;
+}
+
+/**
+ * Demande l'arrêt de l'écoute en cours, ou de la prochaine.  Ne fait qu'écrire dans un tube: peut donc être appelée
+ * d'un autre fil ou d'un gestionnaire de signal.
+ */
+void ServeurRequetes::arreter() {
+    arrete.store(true) ;
+    char octet = 0 ;
+    ssize_t ignore = ::write(autoTube[1], &octet, 1) ;
+    (void) ignore ;
+}
+
+/**
+ * Réveille le fil d'écoute pour qu'il surveille une connexion dont le tampon de sortie n'est pas vide, ou qui est
+ * rompue.  Si le tube est plein, le fil d'écoute a déjà un réveil en attente.
+ */
+void ServeurRequetes::signalerSortie() {
+    char octet = 0 ;
+    ssize_t ignore = ::write(tubeSortie[1], &octet, 1) ;
+    (void) ignore ;
+}
+
+/**
+ * Boucle du fil d'écoute: accepte les connexions, découpe les octets reçus en lignes, dépose les connexions qui ont
+ * une requête prête dans la file des fils de travail et vide les tampons de sortie que les fils de travail n'ont pu
+ * envoyer.  Une connexion dont le tampon de sortie est redescendu sous SORTIE_MAX est redéposée si des requêtes
+ * l'attendent.  Ferme les connexions rompues, celles qui dépassent LIGNE_MAX ou EN_ATTENTE_MAX, et celles dont le
+ * client a fermé son sens d'écriture, une fois leurs requêtes traitées et leurs réponses envoyées.
+ */
+void ServeurRequetes::servir(int ecoute) {
+    std::unordered_map<int, std::shared_ptr<Connexion>> connexions ;
+    std::vector<pollfd> attentes ;
+    std::vector<int> aFermer ;
+    char tampon[65536] ;
+
+    auto fermer = [&](int canal) {
+        auto connexion = connexions.at(canal) ;
+        connexions.erase(canal) ;
+        std::lock_guard<std::mutex> garde(connexion->verrou) ;
+        connexion->rompue = true ;
+        connexion->enAttente.clear() ;
+        connexion->sortie.clear() ;
+    } ;
+
+    while (!arrete.load()) {
+        attentes.clear() ;
+        attentes.push_back({autoTube[0], POLLIN, 0}) ;
+        attentes.push_back({tubeSortie[0], POLLIN, 0}) ;
+        attentes.push_back({ecoute, POLLIN, 0}) ;
+        aFermer.clear() ;
+        for (const auto& entree: connexions) {
+            const Connexion& connexion = *entree.second ;
+            std::lock_guard<std::mutex> garde(entree.second->verrou) ;
+            bool videe = connexion.enAttente.empty() && !connexion.occupee && connexion.sortie.empty() ;
+            if (connexion.rompue || (connexion.terminee && videe)) {
+                aFermer.push_back(entree.first) ;
+                continue ;
+            }
+            // Une connexion terminée n'est surveillée que pour l'envoi: le fil de travail signale la fin de ses
+            // requêtes par le tube de sortie.
+            short evenements = !connexion.terminee && connexion.sortie.size() < SORTIE_MAX ? POLLIN : 0 ;
+            if (!connexion.sortie.empty()) evenements |= POLLOUT ;
+            if (evenements) attentes.push_back({entree.first, evenements, 0}) ;
+        }
+        for (auto canal: aFermer) fermer(canal) ;
+
+        if (::poll(attentes.data(), attentes.size(), -1) < 0) {
+            if (errno == EINTR) continue ;
+            throw std::runtime_error("ServeurRequetes: poll a échoué") ;
+        }
+        if (attentes[0].revents) break ;
+
+        if (attentes[1].revents & POLLIN)
+            while (::read(tubeSortie[0], tampon, sizeof(tampon)) > 0) ;
+
+        if (attentes[2].revents & POLLIN) {
+            int canal = ::accept(ecoute, nullptr, nullptr) ;
+            if (canal >= 0 && !rendreNonBloquant(canal)) ::close(canal) ;
+            else if (canal >= 0) connexions.emplace(canal, std::make_shared<Connexion>(canal)) ;
+        }
+
+        for (size_t i = 3; i < attentes.size(); ++i) {
+            if (!attentes[i].revents) continue ;
+            auto connexion = connexions.at(attentes[i].fd) ;
+
+            if ((attentes[i].events & POLLOUT) && (attentes[i].revents & (POLLOUT | POLLHUP | POLLERR))) {
+                std::lock_guard<std::mutex> garde(connexion->verrou) ;
+                if (!connexion->envoyer()) connexion->rompue = true ;
+                else if (!connexion->occupee && !connexion->enAttente.empty()
+                         && connexion->sortie.size() < SORTIE_MAX) {
+                    connexion->occupee = true ;
+                    deposer(connexion) ;
+                }
+            }
+            if (!(attentes[i].revents & (POLLIN | POLLHUP | POLLERR)) || !(attentes[i].events & POLLIN)) continue ;
+
+            ssize_t lus = ::recv(connexion->canal, tampon, sizeof(tampon), MSG_DONTWAIT) ;
+            if (lus < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) continue ;
+            if (lus < 0) {
+                fermer(attentes[i].fd) ;
+                continue ;
+            }
+            if (lus == 0) {
+                std::lock_guard<std::mutex> garde(connexion->verrou) ;
+                connexion->terminee = true ;
+                continue ;
+            }
+
+            auto reception = Horloge::now() ;
+            connexion->tampon.append(tampon, static_cast<size_t>(lus)) ;
+            size_t debut = 0, finLigne ;
+            bool nouvelles = false, depassement ;
+            {
+                std::lock_guard<std::mutex> garde(connexion->verrou) ;
+                while ((finLigne = connexion->tampon.find('\n', debut)) != std::string::npos) {
+                    std::string ligne = connexion->tampon.substr(debut, finLigne - debut) ;
+                    if (!ligne.empty() && ligne.back() == '\r') ligne.pop_back() ;
+                    if (!ligne.empty()) {
+                        connexion->enAttente.emplace_back(std::move(ligne), reception) ;
+                        nouvelles = true ;
+                    }
+                    debut = finLigne + 1 ;
+                }
+                connexion->tampon.erase(0, debut) ;
+                depassement = connexion->tampon.size() > LIGNE_MAX || connexion->enAttente.size() > EN_ATTENTE_MAX ;
+                if (!depassement && nouvelles && !connexion->occupee && connexion->sortie.size() < SORTIE_MAX) {
+                    connexion->occupee = true ;
+                    deposer(connexion) ;
+                }
+            }
+            if (depassement) fermer(attentes[i].fd) ;
+        }
+    }
+}
+
+/**
+ * Dépose une connexion qui a une requête prête dans la file des fils de travail.
+ */
+void ServeurRequetes::deposer(const std::shared_ptr<Connexion>& connexion) {
+    {
+        std::lock_guard<std::mutex> garde(verrou) ;
+        pretes.push_back(connexion) ;
+    }
+    reveil.notify_one() ;
+}
+
+/**
+ * Boucle d'un fil de travail.  Il prend d'un coup jusqu'à LOT connexions prêtes, traite la première requête en attente
+ * de chacune, envoie sans bloquer ce que la socket accepte de la réponse, puis redépose la connexion si d'autres
+ * requêtes attendent.  Le reste de la réponse est laissé au fil d'écoute; si le tampon de sortie atteint SORTIE_MAX,
+ * la connexion n'est pas redéposée et c'est le fil d'écoute qui la redéposera une fois le tampon vidé.  Le tampon de
+ * sortie ne dépasse donc jamais SORTIE_MAX de plus d'une réponse.
+ */
+void ServeurRequetes::boucleTravailleur(size_t fil) {
+    const size_t LOT = 8 ;
+    std::vector<std::shared_ptr<Connexion>> lot ;
+    std::string reponse ;
+
+    while (true) {
+        bool restantes ;
+        {
+            std::unique_lock<std::mutex> garde(verrou) ;
+            reveil.wait(garde, [this]() {return fin || !pretes.empty() ; }) ;
+            if (fin) return ;
+            while (!pretes.empty() && lot.size() < LOT) {
+                lot.push_back(std::move(pretes.front())) ;
+                pretes.pop_front() ;
+            }
+            restantes = !pretes.empty() ;
+        }
+        if (restantes) reveil.notify_one() ;
+
+        for (auto& connexion: lot) {
+            std::pair<std::string, Horloge::time_point> requete ;
+            {
+                std::lock_guard<std::mutex> garde(connexion->verrou) ;
+                if (connexion->enAttente.empty()) {     // Fermée par le fil d'écoute
+                    connexion->occupee = false ;
+                    continue ;
+                }
+                requete = std::move(connexion->enAttente.front()) ;
+                connexion->enAttente.pop_front() ;
+            }
+
+            reponse = executer(requete.first, fil, requete.second) ;
+            reponse.push_back('\n') ;
+
+            bool signaler ;
+            {
+                std::lock_guard<std::mutex> garde(connexion->verrou) ;
+                if (!connexion->rompue) {
+                    connexion->sortie += reponse ;
+                    if (!connexion->envoyer()) connexion->rompue = true ;
+                }
+                signaler = connexion->rompue || connexion->terminee || !connexion->sortie.empty() ;
+                if (connexion->enAttente.empty() || connexion->rompue || connexion->sortie.size() >= SORTIE_MAX)
+                    connexion->occupee = false ;
+                else deposer(connexion) ;
+            }
+            if (signaler) signalerSortie() ;
+        }
+        lot.clear() ;
+    }
+}
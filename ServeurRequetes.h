@@ -0,0 +1,146 @@
+//
+// Created by Pascal Charpentier on 2023-07-19.
+//
+
+#ifndef SIMPLESGRAPHES_SERVEURREQUETES_H
+#define SIMPLESGRAPHES_SERVEURREQUETES_H
+
+#include "Graphe.h"
+#include "Graphe_algorithmes.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+Graphe chargerGraphe(const std::string& chemin) ;
+
+/**
+ * @class HistogrammeLatences
+ *
+ * Histogramme des latences, en classes de puissances de 2 microsecondes: la classe i compte les durées comprises entre
+ * 2^(i-1) et 2^i microsecondes, la classe 0 celles de moins d'une microseconde.  Les compteurs sont atomiques, de sorte
+ * que tous les fils peuvent enregistrer sans verrou.
+ */
+class HistogrammeLatences {
+public:
+    static constexpr size_t NOMBRE_CLASSES = 40 ;
+
+    void        enregistrer(std::chrono::nanoseconds duree) ;
+
+    uint64_t    nombre()                                       const ;
+
+    uint64_t    quantile(double proportion)                    const ;
+
+    uint64_t    maximum()                                      const ;
+
+    std::string rapport()                                      const ;
+
+private:
+    std::array<std::atomic<uint64_t>, NOMBRE_CLASSES> classes {} ;
+    std::atomic<uint64_t>                             plusLongue {0} ;
+};
+
+/**
+ * @class ServeurRequetes
+ *
+ * Serveur de requêtes sur un graphe chargé une fois pour toutes.  Les clients se connectent par une socket Unix ou
+ * par TCP sur l'interface locale et envoient une requête par ligne; chaque requête reçoit une réponse d'une ligne, qui
+ * commence par OK ou par ERREUR.
+ *
+ * CHEMIN s t       plus court chemin de s à t: OK distance nombre s ... t, ou OK inf 0 si t est inaccessible
+ * BFS s [k]        sommets à au plus k sauts de s (tous par défaut): OK nombre v:sauts ...
+ * CFC s            composante fortement connexe de s: OK identifiant taille, l'identifiant étant son plus petit sommet
+ * STATS            histogrammes de latence, par type de requête
+ *
+ * Un fil d'écoute multiplexe les connexions avec poll et dépose les lignes reçues dans une file commune; les fils de
+ * travail y prennent les connexions prêtes par lots et traitent leurs requêtes avec leur propre espace de travail
+ * (EspaceVoisinage), qui ne coûte aucune allocation en O(n) par requête.  Les requêtes d'une même connexion sont
+ * traitées une à la fois, dans l'ordre; des connexions différentes sont servies en parallèle.  La latence mesurée va
+ * de la réception de la ligne à la mise en file de la réponse.
+ *
+ * Les sockets clientes sont non bloquantes: un fil de travail envoie ce que la socket accepte et laisse le reste dans
+ * le tampon de sortie de la connexion, que le fil d'écoute vide quand la socket redevient disponible.  Un client qui
+ * ne lit pas ses réponses ne bloque donc aucun fil; tant que son tampon de sortie atteint SORTIE_MAX, ses requêtes ne
+ * sont plus ni lues ni traitées, de sorte que ce tampon ne dépasse jamais SORTIE_MAX de plus d'une réponse.  Une
+ * connexion est fermée si une ligne dépasse LIGNE_MAX octets ou si plus de EN_ATTENTE_MAX requêtes attendent d'être
+ * traitées.  Un client qui ferme son sens d'écriture reçoit encore les réponses à toutes ses requêtes.
+ *
+ * Une requête qui porte un argument invalide ou en trop reçoit une réponse ERREUR.
+ */
+class ServeurRequetes {
+public:
+    explicit ServeurRequetes(const Graphe& graphe, size_t nombreFils = 0) ;
+
+    ~ServeurRequetes() ;
+
+    ServeurRequetes(const ServeurRequetes&) = delete ;
+    ServeurRequetes& operator = (const ServeurRequetes&) = delete ;
+
+    size_t      nombreFils()                                   const ;
+
+    std::string traiter(const std::string& requete, size_t fil) ;
+
+    void        ecouterUnix(const std::string& chemin) ;
+
+    void        ecouterTcp(uint16_t port) ;
+
+    void        arreter() ;
+
+    std::string statistiques()                                 const ;
+
+    static constexpr size_t LIGNE_MAX = 65536 ;
+    static constexpr size_t EN_ATTENTE_MAX = 1024 ;
+    static constexpr size_t SORTIE_MAX = 1 << 20 ;
+
+private:
+    using Horloge = std::chrono::steady_clock ;
+
+    struct Connexion ;
+
+    /**
+     * @struct EspaceFil Espace de travail propre à un fil: rien n'y est partagé, rien n'y est réalloué entre requêtes.
+     */
+    struct EspaceFil {
+        EspaceVoisinage<double> distances ;
+        EspaceVoisinage<size_t> sauts ;
+        std::vector<size_t>     chemin ;
+    };
+
+    enum TypeRequete {CHEMIN, BFS, CFC, AUTRE, NOMBRE_TYPES} ;
+
+    std::string executer(const std::string& requete, size_t fil, Horloge::time_point reception) ;
+
+    void        servir(int ecoute) ;
+
+    void        boucleTravailleur(size_t fil) ;
+
+    void        deposer(const std::shared_ptr<Connexion>& connexion) ;
+
+    void        signalerSortie() ;
+
+    const Graphe&                                    graphe ;
+    std::vector<size_t>                              composantes ;
+    std::vector<size_t>                              taillesComposantes ;
+    std::vector<EspaceFil>                           espaces ;
+    std::array<HistogrammeLatences, NOMBRE_TYPES>    latences ;
+
+    std::vector<std::thread>                         fils ;
+    std::mutex                                       verrou ;
+    std::condition_variable                          reveil ;
+    std::deque<std::shared_ptr<Connexion>>           pretes ;
+    bool                                             fin ;
+
+    int                                              autoTube[2] ;
+    int                                              tubeSortie[2] ;
+    std::atomic<bool>                                arrete ;
+};
+
+#endif //SIMPLESGRAPHES_SERVEURREQUETES_H
@@ -0,0 +1,54 @@
+//
+// Created by Pascal Charpentier on 2023-07-24.
+//
+
+#ifndef SIMPLESGRAPHES_VARINT_H
+#define SIMPLESGRAPHES_VARINT_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Codage des entiers en varint (LEB128): 7 bits par octet, des bits de poids faible vers ceux de poids fort, le bit de
+ * poids fort de chaque octet indiquant qu'un autre octet suit.  Les petites valeurs n'occupent ainsi qu'un octet.
+ * Sert à GrapheCompresse et au format sérialisé des arbres de plus courts chemins.
+ */
+
+inline void ecrireVarint(std::vector<uint8_t>& octets, uint64_t valeur) {
+    while (valeur >= 0x80) {
+        octets.push_back(static_cast<uint8_t>(valeur | 0x80)) ;
+        valeur >>= 7 ;
+    }
+    octets.push_back(static_cast<uint8_t>(valeur)) ;
+}
+
+/**
+ * Lit un varint et avance le curseur, sans vérification: les octets doivent avoir été écrits par ecrireVarint.
+ */
+inline uint64_t lireVarint(const uint8_t*& curseur) {
+    uint64_t valeur = *curseur & 0x7F ;
+    if (!(*curseur++ & 0x80)) return valeur ;
+    for (unsigned decalage = 7; ; decalage += 7) {
+        uint8_t octet = *curseur++ ;
+        valeur |= static_cast<uint64_t>(octet & 0x7F) << decalage ;
+        if (!(octet & 0x80)) return valeur ;
+    }
+}
+
+/**
+ * Lit un varint venant d'une source non fiable et avance le curseur.
+ * @except std::invalid_argument si le varint dépasse la fin des données ou 64 bits
+ */
+inline uint64_t lireVarintBorne(const uint8_t*& curseur, const uint8_t* fin) {
+    uint64_t valeur = 0 ;
+    for (unsigned decalage = 0; decalage < 64; decalage += 7) {
+        if (curseur == fin) throw std::invalid_argument("lireVarintBorne: données tronquées") ;
+        uint8_t octet = *curseur++ ;
+        valeur |= static_cast<uint64_t>(octet & 0x7F) << decalage ;
+        if (!(octet & 0x80)) return valeur ;
+    }
+    throw std::invalid_argument("lireVarintBorne: varint trop long") ;
+}
+
+#endif //SIMPLESGRAPHES_VARINT_H
@@ -1,6 +1,78 @@
+//
+// Created by Pascal Charpentier on 2023-07-19.
+//
+
+#include "ServeurRequetes.h"
+
+#include <csignal>
+#include <cstdlib>
 #include <iostream>
+#include <string>
+
+namespace {
+
+    ServeurRequetes* serveurActif = nullptr ;
+
+    void interrompre(int) {
+        if (serveurActif) serveurActif->arreter() ;
+    }
+
+    int usage() {
+        std::cerr << "usage: simplesgraphes <graphe.txt> [--unix <chemin> | --tcp <port>] [--fils <nombre>]\n"
+                  << "Le fichier contient le nombre de sommets, puis une ligne « depart arrivee [poids] » par arc.\n" ;
+        return 2 ;
+    }
+
+}
+
+/**
+ * Démon de requêtes: charge un graphe puis répond aux requêtes CHEMIN, BFS, CFC et STATS (voir ServeurRequetes) sur
+ * une socket Unix, /tmp/simplesgraphes.sock par défaut, ou en TCP sur 127.0.0.1.  SIGINT ou SIGTERM arrêtent le
+ * serveur proprement, après quoi les statistiques de latence sont affichées.
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2) return usage() ;
+
+    std::string fichier = argv[1] ;
+    std::string cheminUnix = "/tmp/simplesgraphes.sock" ;
+    long port = -1 ;
+    long nombreFils = 0 ;
+    for (int i = 2; i < argc; ++i) {
+        std::string option = argv[i] ;
+        if (i + 1 >= argc) return usage() ;
+        if (option == "--unix") cheminUnix = argv[++ i] ;
+        else if (option == "--tcp") port = std::strtol(argv[++ i], nullptr, 10) ;
+        else if (option == "--fils") nombreFils = std::strtol(argv[++ i], nullptr, 10) ;
+        else return usage() ;
+    }
+    if ((port != -1 && (port <= 0 || port > 65535)) || nombreFils < 0) return usage() ;
+
+    try {
+        Graphe graphe = chargerGraphe(fichier) ;
+        std::cerr << "simplesgraphes: " << graphe.taille() << " sommets chargés depuis " << fichier << std::endl ;
+
+        ServeurRequetes serveur(graphe, static_cast<size_t>(nombreFils)) ;
+        serveurActif = &serveur ;
+        std::signal(SIGINT, interrompre) ;
+        std::signal(SIGTERM, interrompre) ;
+
+        if (port != -1) {
+            std::cerr << "simplesgraphes: écoute sur 127.0.0.1:" << port << std::endl ;
+            serveur.ecouterTcp(static_cast<uint16_t>(port)) ;
+        }
+        else {
+            std::cerr << "simplesgraphes: écoute sur " << cheminUnix << std::endl ;
+            serveur.ecouterUnix(cheminUnix) ;
+        }
 
-int main() {
-    std::cout << "Hello, World!" << std::endl;
-    return 0;
+        std::signal(SIGINT, SIG_DFL) ;
+        std::signal(SIGTERM, SIG_DFL) ;
+        serveurActif = nullptr ;
+        std::cerr << "simplesgraphes: " << serveur.statistiques() << std::endl ;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "simplesgraphes: " << e.what() << std::endl ;
+        return 1 ;
+    }
+    return 0 ;
 }
@@ -5,8 +5,84 @@
 #include "Graphe.h"
 #include "GrapheTest.h"
 #include "Graphe_algorithmes.h"
+#include "Biconnexite.h"
+#include "CacheDijkstra.h"
+#include "ComposantesIncrementales.h"
+#include "ServeurRequetes.h"
 #include "gtest/gtest.h"
 
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <random>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * Compteur d'allocations dynamiques.  Les opérateurs new et delete globaux sont remplacés dans cet exécutable de test
+ * afin de vérifier que les algorithmes ne copient ni le graphe, ni leurs structures de travail.  Toutes les formes
+ * (scalaire, tableau, nothrow) sont remplacées, sans quoi un bloc alloué par malloc serait libéré par l'opérateur de
+ * la bibliothèque, ou l'inverse (std::get_temporary_buffer, qu'utilise std::stable_sort, passe par new nothrow).
+ */
+namespace {
+    std::atomic<size_t> compteurAllocations(0) ;
+
+    void* allouerCompte(std::size_t taille) noexcept {
+        ++ compteurAllocations ;
+        return std::malloc(taille ? taille : 1) ;
+    }
+}
+
+void* operator new(std::size_t taille) {
+    if (void* p = allouerCompte(taille)) return p ;
+    throw std::bad_alloc() ;
+}
+
+void* operator new[](std::size_t taille) {
+    if (void* p = allouerCompte(taille)) return p ;
+    throw std::bad_alloc() ;
+}
+
+void* operator new(std::size_t taille, const std::nothrow_t&) noexcept {
+    return allouerCompte(taille) ;
+}
+
+void* operator new[](std::size_t taille, const std::nothrow_t&) noexcept {
+    return allouerCompte(taille) ;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p) ;
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p) ;
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p) ;
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p) ;
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    std::free(p) ;
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    std::free(p) ;
+}
+
 TEST_F(GrapheTest, exploreGrapheDFS_0) {
     std::stack<size_t> attendu ;
     EXPECT_EQ(attendu, exploreRecursifGrapheDFS(g0)) ;
@@ -141,3 +217,1142 @@ TEST_F(GrapheTest, dijkstraFilePrioritaire_6_depart_0) {
     EXPECT_EQ(dist, resultat.distances) ;
 }
 
+
+TEST(Copies, arcExiste_sans_allocation) {
+    Graphe g(3) ;
+    g.ajouterArc(0, 1) ;
+    g.ajouterArc(0, 2) ;
+    size_t avant = compteurAllocations ;
+    EXPECT_TRUE(g.arcExiste(0, 2)) ;
+    EXPECT_EQ(avant, compteurAllocations) ;
+}
+
+TEST(Copies, dijkstra_allocations_lineaires) {
+    const size_t n = 200 ;
+    Graphe g(n) ;
+    for (size_t i = 0; i + 1 < n; ++i) g.ajouterArc(i, i + 1) ;
+    size_t avant = compteurAllocations ;
+    auto resultat = dijkstra(g, 0) ;
+    EXPECT_EQ(n - 1, resultat.distances.at(n - 1)) ;
+    EXPECT_LT(compteurAllocations - avant, 2 * n) ;
+}
+
+TEST(Copies, exploreIteratifDFS_etoile_sans_copie_de_liste) {
+    const size_t n = 200 ;
+    Graphe g(n) ;
+    for (size_t i = 1; i < n; ++i) g.ajouterArc(0, i) ;
+    size_t avant = compteurAllocations ;
+    auto abandonnes = exploreIteratifDFS(g, 0) ;
+    EXPECT_EQ(n, abandonnes.size()) ;
+    EXPECT_LT(compteurAllocations - avant, n) ;
+}
+
+TEST(Copies, kosaraju_ne_copie_pas_le_graphe) {
+    const size_t n = 200 ;
+    Graphe g(n) ;
+    for (size_t i = 0; i < n; ++i) g.ajouterArc(i, (i + 1) % n) ;
+    size_t avant = compteurAllocations ;
+    auto composantes = kosaraju(g) ;
+    EXPECT_EQ(1, composantes.size()) ;
+    // Le graphe inverse (n listes de un arc) et la composante (n noeuds de set) sont les seules allocations en O(n).
+    EXPECT_LT(compteurAllocations - avant, 3 * n) ;
+}
+
+namespace {
+
+    struct VisiteurJournal : VisiteurProfondeur {
+        std::vector<std::string> evenements ;
+
+        void demarrer(size_t racine) {noter("demarrer", racine) ; }
+        void decouvrir(size_t sommet) {noter("decouvrir", sommet) ; }
+        template <typename Arc>
+        void arc(size_t origine, const Arc& arc, TypeArc type) {
+            const char* noms[] {"arbre", "retour", "avant", "transverse"} ;
+            noter(noms[static_cast<int>(type)], origine, arc.destination) ;
+        }
+        void terminer(size_t sommet, size_t parent) {noter("terminer", sommet, parent) ; }
+
+        void noter(const std::string& nom, size_t a) {evenements.push_back(nom + " " + std::to_string(a)) ; }
+        void noter(const std::string& nom, size_t a, size_t b) {noter(nom + " " + std::to_string(a), b) ; }
+    };
+
+    struct VisiteurCycle : VisiteurProfondeur {
+        bool cycle = false ;
+
+        template <typename Arc>
+        void arc(size_t, const Arc&, TypeArc type) {cycle = cycle || type == TypeArc::RETOUR ; }
+        bool interrompre() const {return cycle ; }
+    };
+
+}
+
+TEST(ParcoursProfondeur, classification_des_arcs) {
+    GrapheNonPondere g(4) ;
+    g.ajouterArc(0, 1) ;
+    g.ajouterArc(0, 2) ;
+    g.ajouterArc(1, 2) ;
+    g.ajouterArc(2, 0) ;
+    g.ajouterArc(3, 1) ;
+    g.ajouterArc(3, 3) ;
+    VisiteurJournal journal ;
+    EXPECT_TRUE(parcourirProfondeur(g, journal)) ;
+    std::vector<std::string> attendu {"demarrer 0", "decouvrir 0", "arbre 0 1", "decouvrir 1", "arbre 1 2",
+                                      "decouvrir 2", "retour 2 0", "terminer 2 1", "terminer 1 0", "avant 0 2",
+                                      "terminer 0 4", "demarrer 3", "decouvrir 3", "transverse 3 1", "retour 3 3",
+                                      "terminer 3 4"} ;
+    EXPECT_EQ(attendu, journal.evenements) ;
+
+    VisiteurJournal compresse ;
+    parcourirProfondeur(GrapheCompresse<SansPoids>(g), compresse) ;
+    EXPECT_EQ(attendu, compresse.evenements) ;
+}
+
+TEST(ParcoursProfondeur, interruption_et_racine_unique) {
+    GrapheNonPondere g(4) ;
+    g.ajouterArc(0, 1) ;
+    g.ajouterArc(2, 3) ;
+    g.ajouterArc(3, 2) ;
+    VisiteurCycle acyclique ;
+    EXPECT_TRUE(parcourirProfondeur(g, 0, acyclique)) ;
+    EXPECT_FALSE(acyclique.cycle) ;
+
+    VisiteurCycle cyclique ;
+    EXPECT_FALSE(parcourirProfondeur(g, cyclique)) ;
+    EXPECT_TRUE(cyclique.cycle) ;
+    EXPECT_THROW(parcourirProfondeur(g, 4, cyclique), std::invalid_argument) ;
+}
+
+TEST(ParcoursProfondeur, chaine_profonde_sans_debordement) {
+    const size_t n = 200000 ;
+    GrapheNonPondere g(n) ;
+    for (size_t i = 0; i < n; ++i) g.ajouterArc(i, (i + 1) % n) ;
+    auto abandonnes = exploreIteratifDFS(g, 0) ;
+    ASSERT_EQ(n, abandonnes.size()) ;
+    EXPECT_EQ(0, abandonnes.top()) ;
+    auto composantes = kosaraju(g) ;
+    ASSERT_EQ(1, composantes.size()) ;
+    EXPECT_EQ(n, composantes.begin()->size()) ;
+}
+
+TEST(GrapheCompact, exploreBFS_non_pondere) {
+    GrapheNonPondere g(4) ;
+    g.ajouterArc(0, 1) ;
+    g.ajouterArc(1, 2) ;
+    g.ajouterArc(0, 3) ;
+    std::vector<size_t> attendu {4, 0, 1, 0} ;
+    EXPECT_EQ(attendu, exploreBFS(g, 0)) ;
+    EXPECT_EQ(4, kosaraju(g).size()) ;
+}
+
+TEST(GrapheCompact, dijkstra_poids_float) {
+    GrapheCompact g(4) ;
+    g.ajouterArc(0, 1, 0.5f) ;
+    g.ajouterArc(1, 2, 0.25f) ;
+    g.ajouterArc(0, 2, 1.0f) ;
+    auto resultat = dijkstraFilePrioritaire(g, 0) ;
+    std::vector<float> dist {0.0f, 0.5f, 0.75f, std::numeric_limits<float>::infinity()} ;
+    std::vector<size_t> pred {4, 0, 1, 4} ;
+    EXPECT_EQ(dist, resultat.distances) ;
+    EXPECT_EQ(pred, resultat.predecesseurs) ;
+}
+
+TEST(GrapheCompact, dijkstra_poids_entiers_sans_debordement) {
+    GrapheEntier g(4) ;
+    g.ajouterArc(0, 1, 3) ;
+    g.ajouterArc(1, 2, 4) ;
+    g.ajouterArc(3, 0, 1) ;
+    std::vector<uint32_t> dist {0, 3, 7, std::numeric_limits<uint32_t>::max()} ;
+    EXPECT_EQ(dist, dijkstra(g, 0).distances) ;
+    EXPECT_EQ(dist, dijkstraFilePrioritaire(g, 0).distances) ;
+}
+
+TEST(RelaxationBloc, dijkstra_sommet_pivot_de_haut_degre) {
+    const size_t n = 150 ;
+    Graphe g(n + 1) ;
+    for (size_t i = 1; i <= n; ++i) g.ajouterArc(0, i, static_cast<double>(n - i) + 2.0) ;
+    for (size_t i = 2; i <= n; ++i) g.ajouterArc(i, i - 1, 0.5) ;
+    auto lent = dijkstra(g, 0) ;
+    auto rapide = dijkstraFilePrioritaire(g, 0) ;
+    EXPECT_EQ(lent.distances, rapide.distances) ;
+    EXPECT_EQ(lent.predecesseurs, rapide.predecesseurs) ;
+    EXPECT_EQ(2.0, rapide.distances.at(n)) ;
+    EXPECT_EQ(2.5, rapide.distances.at(n - 1)) ;
+    EXPECT_EQ(n, rapide.predecesseurs.at(n - 1)) ;
+    EXPECT_EQ(0, rapide.predecesseurs.at(n)) ;
+}
+
+TEST(RelaxationBloc, dijkstra_compact_haut_degre) {
+    const size_t n = 70 ;
+    GrapheCompact g(n + 1) ;
+    for (size_t i = 1; i <= n; ++i) g.ajouterArc(0, i, static_cast<float>(i)) ;
+    auto resultat = dijkstraFilePrioritaire(g, 0) ;
+    for (size_t i = 1; i <= n; ++i) {
+        EXPECT_EQ(static_cast<float>(i), resultat.distances.at(i)) ;
+        EXPECT_EQ(0, resultat.predecesseurs.at(i)) ;
+    }
+}
+
+TEST(ReservoirFils, repartir_couvre_tout_l_intervalle) {
+    ReservoirFils reservoir(4) ;
+    std::vector<int> vus(1000, 0) ;
+    reservoir.repartir(vus.size(), [&vus](size_t debut, size_t fin, size_t) {
+        for (size_t i = debut; i < fin; ++i) ++ vus.at(i) ;
+    }) ;
+    EXPECT_EQ(std::vector<int>(1000, 1), vus) ;
+}
+
+TEST(ReservoirFils, repartir_relance_les_exceptions) {
+    ReservoirFils reservoir(3) ;
+    EXPECT_THROW(reservoir.repartir(100, [](size_t debut, size_t, size_t) {
+        if (debut == 0) throw std::runtime_error("échec") ;
+    }), std::runtime_error) ;
+}
+
+TEST_F(GrapheTest, bellmanFord_6_depart_0) {
+    std::vector<size_t> pred {6, 0, 1, 2, 3, 4} ;
+    std::vector<double> dist {0, 1, 2, 3, 4, 5} ;
+    auto resultat = bellmanFord(g6, 0) ;
+    EXPECT_EQ(pred, resultat.predecesseurs) ;
+    EXPECT_EQ(dist, resultat.distances) ;
+}
+
+TEST(BellmanFord, poids_negatifs) {
+    Graphe g(4) ;
+    g.ajouterArc(0, 1, 4) ;
+    g.ajouterArc(0, 2, 1) ;
+    g.ajouterArc(1, 3, -3) ;
+    g.ajouterArc(2, 3, 2) ;
+    std::vector<double> dist {0, 4, 1, 1} ;
+    std::vector<size_t> pred {4, 0, 0, 1} ;
+    auto resultat = bellmanFord(g, 0) ;
+    EXPECT_EQ(dist, resultat.distances) ;
+    EXPECT_EQ(pred, resultat.predecesseurs) ;
+}
+
+TEST(BellmanFord, cycle_negatif) {
+    Graphe g(4) ;
+    g.ajouterArc(0, 1, 1) ;
+    g.ajouterArc(1, 2, -2) ;
+    g.ajouterArc(2, 1, 1) ;
+    EXPECT_THROW(bellmanFord(g, 0), std::invalid_argument) ;
+    EXPECT_NO_THROW(bellmanFord(g, 3)) ;
+}
+
+TEST(BellmanFord, parallele_identique_a_dijkstra) {
+    const size_t n = 2000 ;
+    Graphe g(n) ;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t k = 1; k <= 5; ++k) {
+            size_t j = (i * 7 + k * 131) % n ;
+            if (j != i && !g.arcExiste(i, j)) g.ajouterArc(i, j, static_cast<double>((i + k) % 17 + 1)) ;
+        }
+    ReservoirFils reservoir(4) ;
+    auto attendu = dijkstraFilePrioritaire(g, 0) ;
+    auto resultat = bellmanFord(g, 0, reservoir) ;
+    EXPECT_EQ(attendu.distances, resultat.distances) ;
+}
+
+TEST(Johnson, poids_negatifs) {
+    Graphe g(4) ;
+    g.ajouterArc(0, 1, 4) ;
+    g.ajouterArc(0, 2, 1) ;
+    g.ajouterArc(1, 3, -3) ;
+    g.ajouterArc(2, 3, 2) ;
+    g.ajouterArc(3, 0, 5) ;
+    ReservoirFils reservoir(3) ;
+    auto matrices = johnson(g, true, reservoir) ;
+    for (size_t source = 0; source < g.taille(); ++source) {
+        auto attendu = bellmanFord(g, source) ;
+        for (size_t v = 0; v < g.taille(); ++v) {
+            EXPECT_DOUBLE_EQ(attendu.distances.at(v), matrices.distance(source, v)) ;
+            EXPECT_EQ(attendu.predecesseurs.at(v), matrices.predecesseur(source, v)) ;
+        }
+    }
+}
+
+TEST(Johnson, sommets_inaccessibles_et_cycle_negatif) {
+    Graphe g(3) ;
+    g.ajouterArc(0, 1, -1) ;
+    auto matrices = johnson(g) ;
+    EXPECT_TRUE(matrices.predecesseurs.empty()) ;
+    EXPECT_EQ(-1, matrices.distance(0, 1)) ;
+    EXPECT_EQ(std::numeric_limits<double>::infinity(), matrices.distance(1, 0)) ;
+    EXPECT_EQ(std::numeric_limits<double>::infinity(), matrices.distance(2, 0)) ;
+    g.ajouterArc(1, 0, 0.5) ;
+    EXPECT_THROW(johnson(g), std::invalid_argument) ;
+    try {
+        johnson(g) ;
+    }
+    catch (const std::invalid_argument& e) {
+        EXPECT_EQ(0, std::string(e.what()).find("johnson: ")) << e.what() ;
+    }
+    EXPECT_EQ(0, johnson(Graphe(0)).distances.size()) ;
+}
+
+TEST_F(GrapheTest, johnsonVersFichier_6) {
+    const std::string chemin = ::testing::TempDir() + "johnson_g6.bin" ;
+    johnsonVersFichier(g6, chemin) ;
+    auto matrices = johnson(g6) ;
+
+    std::ifstream fichier(chemin, std::ios::binary) ;
+    uint64_t n = 0 ;
+    fichier.read(reinterpret_cast<char*>(&n), sizeof(n)) ;
+    ASSERT_EQ(6, n) ;
+    std::vector<double> distances(n * n) ;
+    fichier.read(reinterpret_cast<char*>(distances.data()), static_cast<std::streamsize>(n * n * sizeof(double))) ;
+    EXPECT_EQ(matrices.distances, distances) ;
+    EXPECT_EQ(3, distances.at(3)) ;
+    fichier.close() ;
+
+    // Un cycle négatif laisse intact le fichier existant.
+    Graphe cyclique(2) ;
+    cyclique.ajouterArc(0, 1, -1) ;
+    cyclique.ajouterArc(1, 0, 0.5) ;
+    EXPECT_THROW(johnsonVersFichier(cyclique, chemin), std::invalid_argument) ;
+    std::ifstream relu(chemin, std::ios::binary | std::ios::ate) ;
+    EXPECT_EQ(static_cast<std::streamoff>(sizeof(uint64_t) + 36 * sizeof(double)), static_cast<std::streamoff>(relu.tellg())) ;
+    std::remove(chemin.c_str()) ;
+}
+
+TEST(EnsemblesDisjoints, unir_et_trouver) {
+    EnsemblesDisjoints ensembles(5) ;
+    EXPECT_TRUE(ensembles.unir(0, 1)) ;
+    EXPECT_TRUE(ensembles.unir(3, 4)) ;
+    EXPECT_FALSE(ensembles.unir(1, 0)) ;
+    EXPECT_EQ(ensembles.trouver(0), ensembles.trouver(1)) ;
+    EXPECT_NE(ensembles.trouver(1), ensembles.trouver(3)) ;
+    EXPECT_EQ(3, ensembles.nombreEnsembles()) ;
+}
+
+TEST(ArbreCouvrant, petit_graphe) {
+    Graphe g(5) ;
+    g.ajouterArc(0, 1, 4) ;
+    g.ajouterArc(1, 2, 1) ;
+    g.ajouterArc(2, 0, 3) ;
+    g.ajouterArc(0, 2, 5) ;
+    g.ajouterArc(3, 4, 2) ;
+    g.ajouterArc(4, 3, 0.5) ;
+    for (const auto& foret: {prim(g), kruskal(g), boruvka(g)}) {
+        EXPECT_EQ(4.5, foret.poidsTotal) ;
+        EXPECT_EQ(3, foret.aretes.size()) ;
+    }
+    std::vector<AreteNonOrientee<double>> attendu {{3, 4, 0.5}, {1, 2, 1}, {0, 2, 3}} ;
+    EXPECT_EQ(attendu, kruskal(g).aretes) ;
+}
+
+TEST(ArbreCouvrant, trois_algorithmes_concordent) {
+    const size_t n = 1500 ;
+    Graphe g(n) ;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t k = 1; k <= 3; ++k) {
+            size_t j = (i * 13 + k * 97) % n ;
+            if (j != i && !g.arcExiste(i, j)) g.ajouterArc(i, j, static_cast<double>((i * k) % 23)) ;
+        }
+    ReservoirFils reservoir(4) ;
+    auto attendu = kruskal(g) ;
+    EXPECT_EQ(attendu.poidsTotal, prim(g).poidsTotal) ;
+    auto parallele = boruvka(g, reservoir) ;
+    EXPECT_EQ(attendu.poidsTotal, parallele.poidsTotal) ;
+    EXPECT_EQ(attendu.aretes.size(), parallele.aretes.size()) ;
+}
+
+TEST(FlotMaximal, reseau_classique) {
+    Graphe g(6) ;
+    g.ajouterArc(0, 1, 16) ;
+    g.ajouterArc(0, 2, 13) ;
+    g.ajouterArc(1, 2, 10) ;
+    g.ajouterArc(2, 1, 4) ;
+    g.ajouterArc(1, 3, 12) ;
+    g.ajouterArc(3, 2, 9) ;
+    g.ajouterArc(2, 4, 14) ;
+    g.ajouterArc(4, 3, 7) ;
+    g.ajouterArc(3, 5, 20) ;
+    g.ajouterArc(4, 5, 4) ;
+    auto resultat = flotMaximal(g, 0, 5) ;
+    EXPECT_EQ(23, resultat.valeur) ;
+    std::vector<bool> attendu {true, true, true, false, true, false} ;
+    EXPECT_EQ(attendu, resultat.coteSource) ;
+}
+
+TEST(FlotMaximal, coupe_egale_au_flot) {
+    const size_t n = 300 ;
+    GrapheEntier g(n) ;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t k = 1; k <= 4; ++k) {
+            size_t j = (i * 11 + k * 37) % n ;
+            if (j != i && !g.arcExiste(i, j)) g.ajouterArc(i, j, static_cast<uint32_t>((i + 3 * k) % 10)) ;
+        }
+    auto resultat = flotMaximal(g, 0, n - 1) ;
+    uint32_t coupe = 0 ;
+    for (size_t u = 0; u < n; ++u)
+        for (const auto& arc: g.enumererVoisins(u))
+            if (resultat.coteSource[u] && !resultat.coteSource[arc.destination]) coupe += arc.poids ;
+    EXPECT_EQ(coupe, resultat.valeur) ;
+    EXPECT_TRUE(resultat.coteSource[0]) ;
+    EXPECT_FALSE(resultat.coteSource[n - 1]) ;
+}
+
+TEST_F(GrapheTest, flotMaximal_arguments_invalides) {
+    EXPECT_THROW(flotMaximal(g3, 0, 0), std::invalid_argument) ;
+    EXPECT_THROW(flotMaximal(g3, 0, 3), std::invalid_argument) ;
+    EXPECT_EQ(0, flotMaximal(g3, 2, 0).valeur) ;
+}
+
+TEST(PageRank, cycle_uniforme) {
+    Graphe g(4) ;
+    for (size_t i = 0; i < 4; ++i) g.ajouterArc(i, (i + 1) % 4) ;
+    auto resultat = pageRank(g) ;
+    EXPECT_TRUE(resultat.converge) ;
+    for (auto score: resultat.valeurs) EXPECT_NEAR(0.25, score, 1e-9) ;
+}
+
+TEST(PageRank, etoile_et_sommet_orphelin) {
+    GrapheNonPondere g(4) ;
+    g.ajouterArc(1, 0) ;
+    g.ajouterArc(2, 0) ;
+    g.ajouterArc(3, 0) ;
+    ReservoirFils reservoir(2) ;
+    auto resultat = pageRank(g, ParametresPageRank(), reservoir) ;
+    double somme = 0 ;
+    for (auto score: resultat.valeurs) somme += score ;
+    EXPECT_NEAR(1.0, somme, 1e-9) ;
+    EXPECT_GT(resultat.valeurs.at(0), resultat.valeurs.at(1)) ;
+    EXPECT_NEAR(resultat.valeurs.at(1), resultat.valeurs.at(3), 1e-12) ;
+}
+
+TEST(PageRank, personnalisation) {
+    Graphe g(3) ;
+    g.ajouterArc(0, 1) ;
+    g.ajouterArc(1, 0) ;
+    g.ajouterArc(2, 0) ;
+    ParametresPageRank parametres ;
+    parametres.personnalisation = {0, 0, 2} ;
+    auto resultat = pageRank(g, parametres) ;
+    EXPECT_NEAR(0.15, resultat.valeurs.at(2), 1e-9) ;
+    parametres.personnalisation = {1, 1} ;
+    EXPECT_THROW(pageRank(g, parametres), std::invalid_argument) ;
+}
+
+TEST(ProgrammeSommets, limite_d_iterations) {
+    Graphe g(3) ;
+    g.ajouterArc(0, 1) ;
+    g.ajouterArc(1, 2) ;
+    ParametresPageRank parametres ;
+    parametres.iterationsMax = 1 ;
+    auto resultat = pageRank(g, parametres) ;
+    EXPECT_EQ(1, resultat.iterations) ;
+    EXPECT_FALSE(resultat.converge) ;
+}
+
+TEST_F(GrapheTest, intermediarite_chemin) {
+    std::vector<double> attendu {0, 1, 0} ;
+    EXPECT_EQ(attendu, intermediarite(g3)) ;
+}
+
+TEST(Intermediarite, chemins_multiples_et_poids) {
+    Graphe g(4) ;
+    g.ajouterArc(0, 1, 1) ;
+    g.ajouterArc(0, 2, 1) ;
+    g.ajouterArc(1, 3, 1) ;
+    g.ajouterArc(2, 3, 1) ;
+    std::vector<double> attendu {0, 0.5, 0.5, 0} ;
+    EXPECT_EQ(attendu, intermediarite(g)) ;
+
+    g.retirerArc(2, 3) ;
+    g.ajouterArc(2, 3, 5) ;
+    std::vector<double> pondere {0, 1, 0, 0} ;
+    EXPECT_EQ(pondere, intermediarite(g)) ;
+    ParametresIntermediarite parametres ;
+    parametres.ponderee = false ;
+    EXPECT_EQ(attendu, intermediarite(g, parametres)) ;
+}
+
+TEST(Intermediarite, parallele_et_echantillonnage) {
+    const size_t n = 400 ;
+    GrapheNonPondere g(n) ;
+    for (size_t i = 0; i < n; ++i) {
+        g.ajouterArc(i, (i + 1) % n) ;
+        size_t j = (i * 7 + 3) % n ;
+        if (j != i && !g.arcExiste(i, j)) g.ajouterArc(i, j) ;
+    }
+    ReservoirFils seul(1), plusieurs(4) ;
+    auto exacte = intermediarite(g, ParametresIntermediarite(), seul) ;
+    auto parallele = intermediarite(g, ParametresIntermediarite(), plusieurs) ;
+    for (size_t v = 0; v < n; ++v) EXPECT_NEAR(exacte[v], parallele[v], 1e-6) ;
+
+    ParametresIntermediarite parametres ;
+    parametres.erreur = 0.2 ;
+    parametres.probabiliteEchec = 0.1 ;
+    auto approximative = intermediarite(g, parametres, plusieurs) ;
+    EXPECT_NE(exacte, approximative) ;
+    const double normalisation = static_cast<double>((n - 1) * (n - 2)) ;
+    for (size_t v = 0; v < n; ++v) EXPECT_NEAR(exacte[v] / normalisation, approximative[v] / normalisation, 0.2) ;
+}
+
+TEST_F(GrapheTest, composantesFaiblementConnexes) {
+    EXPECT_EQ(std::vector<size_t>{}, composantesFaiblementConnexes(g0)) ;
+    EXPECT_EQ(std::vector<size_t>(6, 0), composantesFaiblementConnexes(g6)) ;
+    Graphe g(5) ;
+    g.ajouterArc(4, 1) ;
+    g.ajouterArc(3, 2) ;
+    std::vector<size_t> attendu {0, 1, 2, 2, 1} ;
+    EXPECT_EQ(attendu, composantesFaiblementConnexes(g)) ;
+}
+
+TEST(ComposantesFaiblementConnexes, parallele_identique_a_incremental) {
+    const size_t n = 5000 ;
+    GrapheNonPondere g(n) ;
+    for (size_t i = 0; i < n; ++i) {
+        size_t j = (i * 31 + 17) % n ;
+        if (i % 10 != 0 && j != i && !g.arcExiste(i, j)) g.ajouterArc(i, j) ;
+    }
+    ReservoirFils reservoir(4) ;
+    ComposantesIncrementales incrementales(g) ;
+    EXPECT_EQ(incrementales.etiquettes(), composantesFaiblementConnexes(g, reservoir)) ;
+}
+
+TEST(ComposantesIncrementales, flot_d_arcs) {
+    ComposantesIncrementales composantes(3) ;
+    EXPECT_EQ(3, composantes.nombreComposantes()) ;
+    composantes.ajouterArc(2, 1) ;
+    EXPECT_TRUE(composantes.memeComposante(1, 2)) ;
+    EXPECT_EQ(1, composantes.composante(2)) ;
+    composantes.ajouterSommet() ;
+    composantes.ajouterArc(3, 0) ;
+    composantes.ajouterArc(1, 3) ;
+    EXPECT_EQ(1, composantes.nombreComposantes()) ;
+    EXPECT_EQ(std::vector<size_t>(4, 0), composantes.etiquettes()) ;
+    EXPECT_THROW(composantes.ajouterArc(0, 4), std::invalid_argument) ;
+}
+
+TEST_F(GrapheTest, voisinageSauts_6) {
+    EspaceVoisinage<size_t> espace ;
+    std::vector<SommetAtteint<size_t>> attendu {{0, 0, 0}, {1, 1, 0}, {2, 2, 1}} ;
+    EXPECT_EQ(attendu, voisinageSauts(g6, 0, 2, espace)) ;
+    std::vector<SommetAtteint<size_t>> depart {{4, 0, 4}} ;
+    EXPECT_EQ(depart, voisinageSauts(g6, 4, 0, espace)) ;
+    EXPECT_EQ(6, voisinageSauts(g6, 2, 100, espace).size()) ;
+    EXPECT_THROW(voisinageSauts(g6, 6, 1, espace), std::invalid_argument) ;
+}
+
+TEST(Voisinage, rayon_pondere) {
+    Graphe g(5) ;
+    g.ajouterArc(0, 1, 2) ;
+    g.ajouterArc(0, 2, 5) ;
+    g.ajouterArc(1, 2, 1) ;
+    g.ajouterArc(2, 3, 1) ;
+    g.ajouterArc(3, 4, 10) ;
+    EspaceVoisinage<double> espace ;
+    std::vector<SommetAtteint<double>> attendu {{0, 0, 0}, {1, 2, 0}, {2, 3, 1}, {3, 4, 2}} ;
+    EXPECT_EQ(attendu, voisinageRayon(g, 0, 4.0, espace)) ;
+    EXPECT_EQ(2, voisinageRayon(g, 0, 2.5, espace).size()) ;
+}
+
+TEST(Voisinage, cout_independant_de_la_taille_du_graphe) {
+    const size_t n = 100000 ;
+    GrapheNonPondere g(n) ;
+    for (size_t i = 0; i + 1 < n; ++i) g.ajouterArc(i, i + 1) ;
+    EspaceVoisinage<size_t> espace ;
+    voisinageSauts(g, 0, 3, espace) ;
+    size_t avant = compteurAllocations ;
+    for (size_t depart = 0; depart < 1000; ++depart) EXPECT_EQ(4, voisinageSauts(g, depart, 3, espace).size()) ;
+    EXPECT_EQ(avant, compteurAllocations) ;
+}
+
+TEST_F(GrapheTest, ordreDegres_6) {
+    auto permutation = ordreDegres(g6) ;
+    std::vector<size_t> attendu {2, 3, 0, 1, 4, 5} ;
+    EXPECT_EQ(attendu, permutation.anciens) ;
+    EXPECT_EQ(2, permutation.nouveaux.at(0)) ;
+}
+
+TEST(Renumerotation, cuthill_mckee_chemin_melange) {
+    Graphe g(5) ;
+    g.ajouterArc(3, 0) ;
+    g.ajouterArc(0, 4) ;
+    g.ajouterArc(4, 1) ;
+    g.ajouterArc(1, 2) ;
+    auto permutation = ordreCuthillMcKeeInverse(g) ;
+    Graphe renumerote = appliquerPermutation(g, permutation) ;
+    for (size_t u = 0; u < renumerote.taille(); ++u)
+        for (const auto& arc: renumerote.enumererVoisins(u))
+            EXPECT_EQ(1, std::max(u, arc.destination) - std::min(u, arc.destination)) ;
+}
+
+TEST(Renumerotation, resultats_preserves) {
+    const size_t n = 300 ;
+    Graphe g(n) ;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t k = 1; k <= 3; ++k) {
+            size_t j = (i * 17 + k * 41) % n ;
+            if (j != i && !g.arcExiste(i, j)) g.ajouterArc(i, j, static_cast<double>(k)) ;
+        }
+    auto attendu = dijkstraFilePrioritaire(g, 0).distances ;
+    for (const auto& permutation: {ordreDegres(g), ordreCuthillMcKeeInverse(g), ordreGorder(g)}) {
+        std::vector<size_t> trie(permutation.anciens) ;
+        std::sort(trie.begin(), trie.end()) ;
+        for (size_t i = 0; i < n; ++i) ASSERT_EQ(i, trie[i]) ;
+
+        Graphe renumerote = appliquerPermutation(g, permutation) ;
+        auto distances = dijkstraFilePrioritaire(renumerote, permutation.nouveaux.at(0)).distances ;
+        EXPECT_EQ(attendu, permutation.versAnciens(distances)) ;
+    }
+}
+
+TEST(Renumerotation, gorder_graphe_sans_arcs) {
+    // Chaque sommet isolé démarre une nouvelle composante: le choix du départ doit rester logarithmique.  Un choix
+    // linéaire coûterait ici de l'ordre de n^2 = 10^10 opérations et dépasserait le délai de ctest.
+    const size_t n = 100000 ;
+    GrapheNonPondere g(n) ;
+    g.ajouterArc(7, 3) ;
+    g.ajouterArc(9, 3) ;
+    auto permutation = ordreGorder(g) ;
+    EXPECT_EQ(3, permutation.anciens[0]) ;
+    EXPECT_EQ(0, permutation.anciens[3]) ;
+    EXPECT_EQ(n - 1, permutation.anciens[n - 1]) ;
+}
+
+TEST(GrapheCompresse, voisins_et_inverse) {
+    Graphe g(300) ;
+    g.ajouterArc(0, 250, 1.5) ;
+    g.ajouterArc(0, 3, 2.5) ;
+    g.ajouterArc(0, 130, 0.5) ;
+    g.ajouterArc(7, 0, 4.0) ;
+    GrapheCompresse<double> compresse(g) ;
+    ASSERT_EQ(300, compresse.taille()) ;
+    EXPECT_EQ(3, compresse.ariteSortie(0)) ;
+    EXPECT_EQ(0, compresse.ariteSortie(1)) ;
+
+    std::vector<size_t> destinations ;
+    std::vector<double> poids ;
+    for (const auto& arc: compresse.enumererVoisins(0)) {
+        destinations.push_back(arc.destination) ;
+        poids.push_back(arc.poids) ;
+    }
+    EXPECT_EQ((std::vector<size_t> {3, 130, 250}), destinations) ;
+    EXPECT_EQ((std::vector<double> {2.5, 0.5, 1.5}), poids) ;
+
+    auto inverse = compresse.grapheInverse() ;
+    EXPECT_EQ(1, inverse.ariteSortie(250)) ;
+    EXPECT_EQ(0, inverse.enumererVoisins(250).begin()->destination) ;
+    EXPECT_EQ(1.5, inverse.enumererVoisins(250).begin()->poids) ;
+    EXPECT_EQ(7, inverse.enumererVoisins(0).begin()->destination) ;
+}
+
+TEST(GrapheCompresse, poids_quantifies) {
+    GrapheEntier g(4) ;
+    g.ajouterArc(0, 1, 10) ;
+    g.ajouterArc(0, 2, 1000) ;
+    g.ajouterArc(1, 3, 505) ;
+    GrapheCompresse<uint32_t> exact(g), quantifie(g, 16), grossier(g, 8) ;
+    EXPECT_EQ(505u, exact.enumererVoisins(1).begin()->poids) ;
+    EXPECT_EQ(505u, quantifie.enumererVoisins(1).begin()->poids) ;
+    EXPECT_NEAR(505.0, grossier.enumererVoisins(1).begin()->poids, 2.0) ;
+    auto it = grossier.enumererVoisins(0).begin() ;
+    EXPECT_EQ(10u, it->poids) ;
+    EXPECT_EQ(1000u, (++ it)->poids) ;
+    EXPECT_LT(grossier.octetsOccupes(), exact.octetsOccupes()) ;
+    EXPECT_THROW(GrapheCompresse<uint32_t>(g, 12), std::invalid_argument) ;
+}
+
+TEST(GrapheCompresse, parcours_comme_graphe_original) {
+    const size_t n = 2000 ;
+    GrapheNonPondere g(n) ;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t k: {1, 2, 5, 37}) {
+            size_t j = (i + k * (i % 3 + 1)) % n ;
+            if (j != i && !g.arcExiste(i, j)) g.ajouterArc(i, j) ;
+        }
+    GrapheCompresse<SansPoids> compresse(g) ;
+    size_t arcs = 0 ;
+    for (size_t i = 0; i < n; ++i) arcs += g.ariteSortie(i) ;
+    EXPECT_LT(compresse.octetsOccupes(), arcs * 3 + n * 10) ;
+
+    auto predecesseurs = exploreBFS(compresse, 0) ;
+    auto attendus = exploreBFS(g, 0) ;
+    for (size_t i = 0; i < n; ++i) EXPECT_EQ(attendus[i] == n, predecesseurs[i] == n) ;
+    EXPECT_EQ(kosaraju(g), kosaraju(compresse)) ;
+
+    auto rangs = pageRank(compresse).valeurs ;
+    auto rangsAttendus = pageRank(g).valeurs ;
+    for (size_t i = 0; i < n; ++i) EXPECT_NEAR(rangsAttendus[i], rangs[i], 1e-6) ;
+}
+
+TEST(CheminPlusCourt, arret_a_l_arrivee) {
+    Graphe g(5) ;
+    g.ajouterArc(0, 1, 1) ;
+    g.ajouterArc(1, 2, 1) ;
+    g.ajouterArc(0, 2, 5) ;
+    g.ajouterArc(2, 3, 1) ;
+    EspaceVoisinage<double> espace ;
+    std::vector<size_t> chemin ;
+    EXPECT_EQ(2, cheminPlusCourt(g, 0, 2, espace, chemin)) ;
+    EXPECT_EQ((std::vector<size_t> {0, 1, 2}), chemin) ;
+    EXPECT_EQ(3, espace.resultats.size()) ;
+    EXPECT_EQ(TraitsPoids<double>::infini(), cheminPlusCourt(g, 0, 4, espace, chemin)) ;
+    EXPECT_TRUE(chemin.empty()) ;
+    EXPECT_EQ(0, cheminPlusCourt(g, 3, 3, espace, chemin)) ;
+    EXPECT_EQ(std::vector<size_t> {3}, chemin) ;
+}
+
+TEST(CheminPlusCourt, sans_espace_fourni) {
+    Graphe g(4) ;
+    g.ajouterArc(0, 1, 1) ;
+    g.ajouterArc(1, 2, 1) ;
+    g.ajouterArc(0, 2, 5) ;
+    auto trouve = cheminPlusCourt(g, 0, 2) ;
+    EXPECT_EQ(2, trouve.longueur) ;
+    EXPECT_EQ((std::vector<size_t> {0, 1, 2}), trouve.sommets) ;
+    trouve = cheminPlusCourt(g, 0, 3) ;
+    EXPECT_EQ(TraitsPoids<double>::infini(), trouve.longueur) ;
+    EXPECT_TRUE(trouve.sommets.empty()) ;
+}
+
+TEST_F(GrapheTest, extraireCheminBFS_g6) {
+    std::vector<size_t> chemin ;
+    auto predecesseurs = exploreBFS(g6, 2) ;
+    EXPECT_TRUE(extraireCheminBFS(predecesseurs, 2, 5, chemin)) ;
+    EXPECT_EQ((std::vector<size_t> {2, 3, 4, 5}), chemin) ;
+    EXPECT_TRUE(extraireCheminBFS(predecesseurs, 2, 2, chemin)) ;
+    EXPECT_EQ(std::vector<size_t> {2}, chemin) ;
+    EXPECT_FALSE(extraireCheminBFS(exploreBFS(g6, 3), 3, 0, chemin)) ;
+    EXPECT_TRUE(chemin.empty()) ;
+    EXPECT_THROW(extraireCheminBFS(predecesseurs, 2, 6, chemin), std::invalid_argument) ;
+}
+
+TEST_F(GrapheTest, serialiserArbre_aller_retour) {
+    auto resultats = dijkstraFilePrioritaire(g6, 2) ;
+    std::vector<uint8_t> octets ;
+    serialiserArbre(resultats, octets) ;
+    auto relus = deserialiserArbre<double>(octets, g6.taille()) ;
+    EXPECT_EQ(resultats.predecesseurs, relus.predecesseurs) ;
+    EXPECT_EQ(resultats.distances, relus.distances) ;
+
+    std::vector<size_t> chemin ;
+    EXPECT_EQ(extraireChemin(resultats, 5, chemin), extraireChemin(relus, 5, chemin)) ;
+    EXPECT_EQ((std::vector<size_t> {2, 3, 4, 5}), chemin) ;
+}
+
+TEST(SerialiserArbre, compacite_et_validation) {
+    const size_t n = 1000 ;
+    GrapheGenerique<uint32_t, uint32_t> g(n) ;
+    for (size_t i = 0; i + 1 < n; ++i) g.ajouterArc(i, i + 1, 1) ;
+    auto resultats = dijkstraFilePrioritaire(g, 0) ;
+    std::vector<uint8_t> octets ;
+    serialiserArbre(resultats, octets) ;
+    EXPECT_LT(octets.size(), (n - 1) * (2 + sizeof(uint32_t)) + 16) ;
+    EXPECT_EQ(resultats.distances, deserialiserArbre<uint32_t>(octets, n).distances) ;
+
+    std::vector<uint8_t> tronques(octets.begin(), octets.end() - 1) ;
+    EXPECT_THROW(deserialiserArbre<uint32_t>(tronques, n), std::invalid_argument) ;
+
+    // Deux sommets qui se désignent l'un l'autre comme prédécesseur: n = 3, source 0, sommets 1 et 2.
+    std::vector<uint8_t> cycle {3, 0, 2, 1, 2, 1, 0, 0, 0, 0, 1, 1, 0, 0, 0} ;
+    EXPECT_THROW(deserialiserArbre<uint32_t>(cycle, n), std::invalid_argument) ;
+
+    // En-têtes minuscules annonçant 2^40 et 2^62 sommets: refusés avant toute allocation.
+    std::vector<uint8_t> enorme ;
+    for (uint64_t annonce: {uint64_t(1) << 40, uint64_t(1) << 62}) {
+        enorme.clear() ;
+        ecrireVarint(enorme, annonce) ;
+        enorme.insert(enorme.end(), {0, 0}) ;
+        EXPECT_THROW(deserialiserArbre<uint32_t>(enorme, n), std::invalid_argument) ;
+    }
+}
+
+TEST(HistogrammeLatences, quantiles) {
+    HistogrammeLatences histogramme ;
+    for (int i = 0; i < 99; ++i) histogramme.enregistrer(std::chrono::microseconds(3)) ;
+    histogramme.enregistrer(std::chrono::milliseconds(5)) ;
+    EXPECT_EQ(100, histogramme.nombre()) ;
+    EXPECT_EQ(4, histogramme.quantile(0.5)) ;
+    EXPECT_EQ(4, histogramme.quantile(0.99)) ;
+    EXPECT_EQ(5000, histogramme.quantile(1.0)) ;
+    EXPECT_EQ(5000, histogramme.maximum()) ;
+}
+
+class ServeurTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        chemin = cheminUnique(".txt") ;
+        std::ofstream fichier(chemin) ;
+        fichier << "# petit graphe\n5\n0 1 1.5\n1 2 2\n2 0\n2 3 4\n\n" ;
+    }
+
+    void TearDown() override {
+        std::remove(chemin.c_str()) ;
+    }
+
+    /**
+     * @return Un chemin temporaire propre au test et au processus: ctest lance chaque test dans son propre processus,
+     * éventuellement en parallèle.
+     */
+    static std::string cheminUnique(const std::string& extension) {
+        return ::testing::TempDir() + "sg" + std::to_string(::getpid()) + "_"
+               + ::testing::UnitTest::GetInstance()->current_test_info()->name() + extension ;
+    }
+
+    /**
+     * Se connecte à la socket d'un serveur qui démarre dans un autre fil.  Les lectures expirent après 10 secondes.
+     */
+    static int connecter(const std::string& socket) {
+        int canal = -1 ;
+        for (int essai = 0; essai < 200 && canal < 0; ++essai) {
+            canal = ::socket(AF_UNIX, SOCK_STREAM, 0) ;
+            sockaddr_un adresse {} ;
+            adresse.sun_family = AF_UNIX ;
+            std::strncpy(adresse.sun_path, socket.c_str(), sizeof(adresse.sun_path) - 1) ;
+            if (::connect(canal, reinterpret_cast<sockaddr*>(&adresse), sizeof(adresse)) != 0) {
+                ::close(canal) ;
+                canal = -1 ;
+                std::this_thread::sleep_for(std::chrono::milliseconds(10)) ;
+            }
+        }
+        timeval delai {10, 0} ;
+        if (canal >= 0) ::setsockopt(canal, SOL_SOCKET, SO_RCVTIMEO, &delai, sizeof(delai)) ;
+        return canal ;
+    }
+
+    /**
+     * Lit jusqu'à la fermeture par le serveur.
+     * @return Le nombre de lignes reçues, ou -1 si la lecture a expiré
+     */
+    static long lireJusquaFermeture(int canal) {
+        long lignes = 0 ;
+        char tampon[4096] ;
+        ssize_t lus ;
+        while ((lus = ::recv(canal, tampon, sizeof(tampon), 0)) > 0) lignes += std::count(tampon, tampon + lus, '\n') ;
+        return lus < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) ? -1 : lignes ;
+    }
+
+    std::string chemin ;
+};
+
+TEST_F(ServeurTest, requetes_directes) {
+    Graphe g = chargerGraphe(chemin) ;
+    ASSERT_EQ(5, g.taille()) ;
+    EXPECT_EQ(1, g.enumererVoisins(2).front().poids) ;
+
+    ServeurRequetes serveur(g, 2) ;
+    EXPECT_EQ("OK 3.5 3 0 1 2", serveur.traiter("CHEMIN 0 2", 0)) ;
+    EXPECT_EQ("OK inf 0", serveur.traiter("chemin 0 4", 1)) ;
+    EXPECT_EQ("OK 4 0:0 1:1 2:2 3:3", serveur.traiter("BFS 0", 0)) ;
+    EXPECT_EQ("OK 2 0:0 1:1", serveur.traiter("BFS 0 1", 0)) ;
+    EXPECT_EQ("OK 0 3", serveur.traiter("CFC 2", 0)) ;
+    EXPECT_EQ("OK 3 1", serveur.traiter("CFC 3", 0)) ;
+    EXPECT_EQ(0, serveur.traiter("CHEMIN 0 9", 0).find("ERREUR")) ;
+    EXPECT_EQ(0, serveur.traiter("BONJOUR", 0).find("ERREUR")) ;
+    EXPECT_NE(std::string::npos, serveur.traiter("STATS", 0).find("CHEMIN n=3")) ;
+    EXPECT_EQ(0, serveur.traiter("BFS 0 abc", 0).find("ERREUR")) ;
+    EXPECT_EQ(0, serveur.traiter("BFS 0 1 2", 0).find("ERREUR")) ;
+    EXPECT_EQ(0, serveur.traiter("CHEMIN 0 2 x", 0).find("ERREUR")) ;
+    EXPECT_EQ(0, serveur.traiter("CFC 2 3", 0).find("ERREUR")) ;
+    EXPECT_EQ(0, serveur.traiter("CFC 2abc", 0).find("ERREUR")) ;
+    EXPECT_EQ(0, serveur.traiter("\xc3\xa9t\xc3\xa9 0", 0).find("ERREUR")) ;
+    EXPECT_EQ("OK 0 3", serveur.traiter("cfc 2  ", 0)) ;
+}
+
+TEST_F(ServeurTest, lignes_mal_formees) {
+    for (const char* contenu: {"3\n0 1 abc\n", "3\n0 1 -2\n", "3\n0 1 2 3\n", "3\n0 1 2x\n", "3\n0 -1\n",
+                               "3 4\n", "3\n0 1 nan\n"}) {
+        {
+            std::ofstream fichier(chemin) ;
+            fichier << contenu ;
+        }
+        EXPECT_THROW(chargerGraphe(chemin), std::invalid_argument) << contenu ;
+    }
+}
+
+TEST_F(ServeurTest, socket_unix) {
+    Graphe g = chargerGraphe(chemin) ;
+    ServeurRequetes serveur(g, 2) ;
+    const std::string socket = cheminUnique(".sock") ;
+    std::thread ecoute([&]() {serveur.ecouterUnix(socket) ; }) ;
+    int canal = connecter(socket) ;
+    ASSERT_GE(canal, 0) ;
+
+    const std::string requetes = "CHEMIN 0 3\nCFC 1\r\nBFS 4\n" ;
+    ASSERT_EQ(static_cast<ssize_t>(requetes.size()), ::send(canal, requetes.data(), requetes.size(), 0)) ;
+    std::string reponses ;
+    char tampon[256] ;
+    while (std::count(reponses.begin(), reponses.end(), '\n') < 3) {
+        ssize_t lus = ::recv(canal, tampon, sizeof(tampon), 0) ;
+        ASSERT_GT(lus, 0) ;
+        reponses.append(tampon, static_cast<size_t>(lus)) ;
+    }
+    EXPECT_EQ("OK 7.5 4 0 1 2 3\nOK 0 3\nOK 1 4:0\n", reponses) ;
+
+    ::close(canal) ;
+    serveur.arreter() ;
+    ecoute.join() ;
+}
+
+TEST_F(ServeurTest, client_qui_ne_lit_pas) {
+    const size_t n = 50000 ;
+    Graphe g(n) ;
+    for (size_t i = 0; i + 1 < n; ++i) g.ajouterArc(i, i + 1) ;
+    ServeurRequetes serveur(g, 1) ;
+    const std::string socket = cheminUnique(".sock") ;
+    std::thread ecoute([&]() {serveur.ecouterUnix(socket) ; }) ;
+
+    // Plusieurs mégaoctets de réponses que le client ne lit jamais: le seul fil de travail ne doit pas rester bloqué.
+    int lent = connecter(socket) ;
+    ASSERT_GE(lent, 0) ;
+    std::string requetes ;
+    for (int i = 0; i < 8; ++i) requetes += "BFS 0\n" ;
+    ASSERT_EQ(static_cast<ssize_t>(requetes.size()), ::send(lent, requetes.data(), requetes.size(), 0)) ;
+    std::this_thread::sleep_for(std::chrono::milliseconds(200)) ;
+
+    int canal = connecter(socket) ;
+    ASSERT_GE(canal, 0) ;
+    ASSERT_EQ(6, ::send(canal, "CFC 7\n", 6, 0)) ;
+    char tampon[64] ;
+    ssize_t lus = ::recv(canal, tampon, sizeof(tampon), 0) ;
+    ASSERT_GT(lus, 0) ;
+    EXPECT_EQ("OK 7 1\n", std::string(tampon, static_cast<size_t>(lus))) ;
+
+    ::close(canal) ;
+    ::close(lent) ;
+    serveur.arreter() ;
+    ecoute.join() ;
+}
+
+TEST_F(ServeurTest, tampon_de_sortie_borne) {
+    const size_t n = 50000 ;
+    Graphe g(n) ;
+    for (size_t i = 0; i + 1 < n; ++i) g.ajouterArc(i, i + 1) ;
+    ServeurRequetes serveur(g, 2) ;
+    const std::string socket = cheminUnique(".sock") ;
+    std::thread ecoute([&]() {serveur.ecouterUnix(socket) ; }) ;
+
+    // Chaque réponse fait environ 600 ko: seules quelques-unes tiennent dans la socket et SORTIE_MAX, les autres
+    // requêtes doivent attendre que le client lise.
+    int canal = connecter(socket) ;
+    ASSERT_GE(canal, 0) ;
+    const int nombre = 32 ;
+    std::string requetes ;
+    for (int i = 0; i < nombre; ++i) requetes += "BFS 0\n" ;
+    ASSERT_EQ(static_cast<ssize_t>(requetes.size()), ::send(canal, requetes.data(), requetes.size(), 0)) ;
+    std::this_thread::sleep_for(std::chrono::milliseconds(500)) ;
+    auto traitees = [&serveur]() {
+        const std::string rapport = serveur.statistiques() ;
+        return std::stoi(rapport.substr(rapport.find("BFS n=") + 6)) ;
+    } ;
+    EXPECT_LE(traitees(), 10) ;
+
+    std::string debut ;
+    char tampon[65536] ;
+    for (long lignes = 0; lignes < nombre; ) {
+        ssize_t lus = ::recv(canal, tampon, sizeof(tampon), 0) ;
+        ASSERT_GT(lus, 0) ;
+        if (debut.empty()) debut.assign(tampon, static_cast<size_t>(lus)) ;
+        lignes += std::count(tampon, tampon + lus, '\n') ;
+    }
+    EXPECT_EQ(nombre, traitees()) ;
+    EXPECT_EQ(0, debut.find("OK 50000 0:0 1:1")) ;
+
+    ::close(canal) ;
+    serveur.arreter() ;
+    ecoute.join() ;
+}
+
+TEST_F(ServeurTest, fermeture_en_ecriture_du_client) {
+    const size_t n = 50000 ;
+    Graphe g(n) ;
+    for (size_t i = 0; i + 1 < n; ++i) g.ajouterArc(i, i + 1) ;
+    ServeurRequetes serveur(g, 1) ;
+    const std::string socket = cheminUnique(".sock") ;
+    std::thread ecoute([&]() {serveur.ecouterUnix(socket) ; }) ;
+
+    // Le client envoie ses requêtes et ferme aussitôt son sens d'écriture, comme « nc -N »: il doit recevoir toutes
+    // ses réponses, puis la fermeture.
+    int canal = connecter(socket) ;
+    ASSERT_GE(canal, 0) ;
+    const std::string requetes = "BFS 0\nBFS 1\nCFC 3\nCHEMIN 0 9\n" ;
+    ASSERT_EQ(static_cast<ssize_t>(requetes.size()), ::send(canal, requetes.data(), requetes.size(), 0)) ;
+    ASSERT_EQ(0, ::shutdown(canal, SHUT_WR)) ;
+    EXPECT_EQ(4, lireJusquaFermeture(canal)) ;
+
+    ::close(canal) ;
+    serveur.arreter() ;
+    ecoute.join() ;
+}
+
+TEST_F(ServeurTest, limites_de_connexion) {
+    Graphe g = chargerGraphe(chemin) ;
+    ServeurRequetes serveur(g, 1) ;
+    const std::string socket = cheminUnique(".sock") ;
+    std::thread ecoute([&]() {serveur.ecouterUnix(socket) ; }) ;
+
+    int canal = connecter(socket) ;
+    ASSERT_GE(canal, 0) ;
+    std::string ligne(ServeurRequetes::LIGNE_MAX + 1, 'x') ;
+    ::send(canal, ligne.data(), ligne.size(), MSG_NOSIGNAL) ;
+    EXPECT_EQ(0, lireJusquaFermeture(canal)) ;
+    ::close(canal) ;
+
+    canal = connecter(socket) ;
+    ASSERT_GE(canal, 0) ;
+    const long nombre = 4 * static_cast<long>(ServeurRequetes::EN_ATTENTE_MAX) ;
+    std::string requetes ;
+    for (long i = 0; i < nombre; ++i) requetes += "CFC 0\n" ;
+    ::send(canal, requetes.data(), requetes.size(), MSG_NOSIGNAL) ;
+    long recues = lireJusquaFermeture(canal) ;
+    EXPECT_GE(recues, 0) ;
+    EXPECT_LT(recues, nombre) ;
+    ::close(canal) ;
+
+    serveur.arreter() ;
+    ecoute.join() ;
+}
+
+TEST_F(GrapheTest, version_change_a_chaque_modification) {
+    auto version = g6.version() ;
+    g6.ajouterArc(5, 0) ;
+    EXPECT_NE(version, g6.version()) ;
+    version = g6.version() ;
+    g6.retirerArc(5, 0) ;
+    EXPECT_NE(version, g6.version()) ;
+    version = g6.version() ;
+    g6.retirerSommet(5) ;
+    EXPECT_NE(version, g6.version()) ;
+    EXPECT_NE(Graphe(3).version(), Graphe(3).version()) ;
+}
+
+TEST_F(GrapheTest, cache_succes_et_invalidation) {
+    CacheDijkstra<size_t, double> cache(g6, 1 << 20) ;
+    auto premier = cache.obtenir(0) ;
+    auto second = cache.obtenir(0) ;
+    EXPECT_EQ(premier.get(), second.get()) ;
+    EXPECT_EQ(1, cache.succes()) ;
+    EXPECT_EQ(1, cache.echecs()) ;
+    EXPECT_EQ(dijkstraFilePrioritaire(g6, 0).distances, premier->distances) ;
+
+    std::vector<size_t> chemin ;
+    EXPECT_EQ(extraireChemin(dijkstraFilePrioritaire(g6, 0), 4, chemin), cache.chemin(0, 4, chemin)) ;
+    EXPECT_EQ(0, chemin.front()) ;
+    EXPECT_EQ(4, chemin.back()) ;
+
+    g6.ajouterArc(0, 4, 0.5) ;
+    EXPECT_EQ(0.5, cache.chemin(0, 4, chemin)) ;
+    EXPECT_EQ((std::vector<size_t> {0, 4}), chemin) ;
+    EXPECT_EQ(2, cache.echecs()) ;
+    EXPECT_NE(0.5, premier->distances.at(4)) ;
+}
+
+TEST(CacheDijkstra, budget_et_politiques) {
+    Graphe g(100) ;
+    for (size_t i = 0; i + 1 < 100; ++i) g.ajouterArc(i, i + 1) ;
+    const size_t entree = sizeof(ResultatsDijkstra) + 100 * (sizeof(double) + sizeof(size_t)) ;
+
+    CacheDijkstra<size_t, double> lru(g, 2 * entree) ;
+    lru.obtenir(1) ;
+    lru.obtenir(2) ;
+    lru.obtenir(1) ;
+    lru.obtenir(3) ;
+    EXPECT_EQ(2, lru.nombreEntrees()) ;
+    EXPECT_LE(lru.octetsUtilises(), 2 * entree) ;
+    EXPECT_EQ(1, lru.evictions()) ;
+    lru.obtenir(1) ;
+    EXPECT_EQ(2, lru.succes()) ;
+
+    CacheDijkstra<size_t, double> lfu(g, 2 * entree, PolitiqueEviction::LFU) ;
+    for (int i = 0; i < 3; ++i) lfu.obtenir(1) ;
+    lfu.obtenir(2) ;
+    lfu.obtenir(3) ;
+    lfu.obtenir(1) ;
+    EXPECT_EQ(3, lfu.succes()) ;
+
+    CacheDijkstra<size_t, double> minuscule(g, 16) ;
+    EXPECT_EQ(100, minuscule.obtenir(0)->distances.size()) ;
+    EXPECT_EQ(0, minuscule.nombreEntrees()) ;
+}
+
+TEST(Biconnexite, deux_triangles_et_un_pont) {
+    // Triangles 0-1-2 et 2-3-4 partageant le sommet 2, pont 4-5, sommet 6 isolé.  Arcs dans les deux sens et boucle.
+    GrapheNonPondere g(7) ;
+    for (auto arete: std::vector<std::pair<size_t, size_t>> {{0, 1}, {1, 2}, {2, 0}, {2, 3}, {3, 4}, {4, 2}, {4, 5}}) {
+        g.ajouterArc(arete.first, arete.second) ;
+        g.ajouterArc(arete.second, arete.first) ;
+    }
+    g.ajouterArc(6, 6) ;
+    auto resultat = biconnexite(g) ;
+    std::vector<std::pair<size_t, size_t>> aretes {{0, 1}, {0, 2}, {1, 2}, {2, 3}, {2, 4}, {3, 4}, {4, 5}} ;
+    EXPECT_EQ(aretes, resultat.aretes) ;
+    EXPECT_EQ((std::vector<size_t> {0, 0, 0, 1, 1, 1, 2}), resultat.composantes) ;
+    EXPECT_EQ(3, resultat.nombreComposantes) ;
+    EXPECT_EQ((std::vector<size_t> {2, 4}), resultat.pointsArticulation) ;
+    EXPECT_EQ(std::vector<size_t> {6}, resultat.ponts) ;
+
+    auto parallele = biconnexiteParallele(g) ;
+    EXPECT_EQ(resultat.composantes, parallele.composantes) ;
+    EXPECT_EQ(resultat.pointsArticulation, parallele.pointsArticulation) ;
+    EXPECT_EQ(resultat.ponts, parallele.ponts) ;
+}
+
+TEST(Biconnexite, conforme_a_la_force_brute) {
+    std::mt19937 generateur(17) ;
+    ReservoirFils reservoir(4) ;
+    for (int essai = 0; essai < 50; ++essai) {
+        const size_t n = 12 ;
+        GrapheNonPondere g(n) ;
+        std::uniform_int_distribution<size_t> sommets(0, n - 1) ;
+        for (int i = 0; i < 16; ++i) {
+            size_t u = sommets(generateur), v = sommets(generateur) ;
+            if (!g.arcExiste(u, v)) g.ajouterArc(u, v) ;
+        }
+
+        auto resultat = biconnexite(g) ;
+        auto parallele = biconnexiteParallele(g, reservoir) ;
+        ASSERT_EQ(resultat.composantes, parallele.composantes) ;
+        EXPECT_EQ(resultat.pointsArticulation, parallele.pointsArticulation) ;
+        EXPECT_EQ(resultat.ponts, parallele.ponts) ;
+
+        // Nombre de composantes connexes de la vue non orientée, sans un sommet ou sans une arête.
+        auto compter = [&](size_t sommetRetire, size_t areteRetiree) {
+            EnsemblesDisjoints ensembles(n) ;
+            for (size_t arete = 0; arete < resultat.aretes.size(); ++arete) {
+                auto u = resultat.aretes[arete].first, v = resultat.aretes[arete].second ;
+                if (arete != areteRetiree && u != sommetRetire && v != sommetRetire) ensembles.unir(u, v) ;
+            }
+            return ensembles.nombreEnsembles() - (sommetRetire < n ? 1 : 0) ;
+        } ;
+        const size_t base = compter(n, resultat.aretes.size()) ;
+        std::vector<size_t> articulations, ponts ;
+        for (size_t sommet = 0; sommet < n; ++sommet)
+            if (compter(sommet, resultat.aretes.size()) > base) articulations.push_back(sommet) ;
+        for (size_t arete = 0; arete < resultat.aretes.size(); ++arete)
+            if (compter(n, arete) > base) ponts.push_back(arete) ;
+        EXPECT_EQ(articulations, resultat.pointsArticulation) ;
+        EXPECT_EQ(ponts, resultat.ponts) ;
+    }
+}
+
+TEST(Biconnexite, parallele_sur_grand_graphe) {
+    const size_t n = 20000 ;
+    std::mt19937 generateur(3) ;
+    std::uniform_int_distribution<size_t> sommets(0, n - 1) ;
+    GrapheNonPondere g(n) ;
+    for (size_t i = 0; i < n; ++i) {
+        size_t u = sommets(generateur), v = sommets(generateur) ;
+        if (!g.arcExiste(u, v)) g.ajouterArc(u, v) ;
+    }
+    ReservoirFils reservoir(4) ;
+    auto resultat = biconnexite(g) ;
+    auto parallele = biconnexiteParallele(g, reservoir) ;
+    EXPECT_EQ(resultat.composantes, parallele.composantes) ;
+    EXPECT_EQ(resultat.pointsArticulation, parallele.pointsArticulation) ;
+    EXPECT_EQ(resultat.ponts, parallele.ponts) ;
+}
+
+TEST(Biconnexite, longue_chaine) {
+    const size_t n = 100000 ;
+    GrapheNonPondere g(n) ;
+    for (size_t i = 0; i + 1 < n; ++i) g.ajouterArc(i, i + 1) ;
+    g.ajouterArc(n - 1, n - 3) ;
+    auto resultat = biconnexite(g) ;
+    EXPECT_EQ(n - 2, resultat.nombreComposantes) ;
+    EXPECT_EQ(n - 3, resultat.ponts.size()) ;
+    EXPECT_EQ(n - 3, resultat.pointsArticulation.size()) ;
+    EXPECT_EQ(resultat.composantes, biconnexiteParallele(g).composantes) ;
+}
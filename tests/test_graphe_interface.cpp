@@ -43,8 +43,8 @@ TEST_F(GrapheTest, graphe_trois_sommets_ajouter_arc) {
 }
 
 TEST_F(GrapheTest, liste_adjacence) {
-    std::list<Graphe::Arc> attendu {{1, 1.0}} ;
-    std::list<Graphe::Arc> vide {} ;
+    Graphe::ListeArcs attendu {{1, 1.0}} ;
+    Graphe::ListeArcs vide {} ;
     EXPECT_EQ(attendu, g3.enumererVoisins(0)) ;
     EXPECT_EQ(vide, g3.enumererVoisins(2)) ;
 }
@@ -106,3 +106,67 @@ TEST_F(GrapheTest, retirerArc_g2_01) {
     EXPECT_FALSE(g2.arcExiste(0, 1)) ;
     EXPECT_EQ(2, g2.taille()) ;
 }
+
+TEST(Graphe, arena_comportement_identique) {
+    auto arena = std::make_shared<ArenaArcs>() ;
+    Graphe g(3, arena) ;
+    g.ajouterArc(0, 1, 2.0) ;
+    g.ajouterArc(1, 2) ;
+    g.ajouterSommet() ;
+    g.ajouterArc(3, 0) ;
+    EXPECT_TRUE(g.arcExiste(0, 1)) ;
+    EXPECT_TRUE(g.arcExiste(3, 0)) ;
+    EXPECT_EQ(1, g.ariteEntree(0)) ;
+    Graphe::ListeArcs attendu {{1, 2.0}} ;
+    EXPECT_EQ(attendu, g.enumererVoisins(0)) ;
+    g.retirerSommet(1) ;
+    EXPECT_FALSE(g.arcExiste(0, 1)) ;
+    EXPECT_TRUE(g.arcExiste(2, 0)) ;
+}
+
+TEST(Graphe, arena_peu_de_blocs) {
+    auto arena = std::make_shared<ArenaArcs>() ;
+    {
+        Graphe g(1000, arena) ;
+        for (size_t i = 0; i + 1 < 1000; ++i) g.ajouterArc(i, i + 1) ;
+        Graphe inverse = g.grapheInverse() ;
+        EXPECT_TRUE(inverse.arcExiste(1, 0)) ;
+    }
+    EXPECT_LT(arena->nombreBlocs(), 4) ;
+}
+
+TEST(Graphe, arena_recycle_arcs_retires) {
+    auto arena = std::make_shared<ArenaArcs>(256) ;
+    Graphe g(2, arena) ;
+    g.ajouterArc(0, 1) ;
+    size_t reserves = arena->octetsReserves() ;
+    for (int i = 0; i < 100; ++i) {
+        g.retirerArc(0, 1) ;
+        g.ajouterArc(0, 1) ;
+    }
+    EXPECT_EQ(reserves, arena->octetsReserves()) ;
+}
+
+TEST(GrapheCompact, taille_des_arcs) {
+    EXPECT_EQ(8, sizeof(GrapheCompact::Arc)) ;
+    EXPECT_EQ(8, sizeof(GrapheEntier::Arc)) ;
+    EXPECT_EQ(4, sizeof(GrapheNonPondere::Arc)) ;
+}
+
+TEST(GrapheCompact, non_pondere_interface) {
+    GrapheNonPondere g(3) ;
+    g.ajouterArc(0, 1) ;
+    g.ajouterArc(1, 2) ;
+    EXPECT_TRUE(g.arcExiste(0, 1)) ;
+    EXPECT_FALSE(g.arcExiste(1, 0)) ;
+    GrapheNonPondere inverse = g.grapheInverse() ;
+    EXPECT_TRUE(inverse.arcExiste(2, 1)) ;
+    g.retirerSommet(0) ;
+    EXPECT_TRUE(g.arcExiste(0, 1)) ;
+    EXPECT_EQ(1, g.ariteEntree(1)) ;
+}
+
+TEST(GrapheCompact, capacite_du_type_sommet) {
+    using GrapheMinuscule = GrapheGenerique<uint32_t, float> ;
+    EXPECT_THROW(GrapheMinuscule g(static_cast<size_t>(std::numeric_limits<uint32_t>::max()) + 1), std::length_error) ;
+}
@@ -0,0 +1,129 @@
+//
+// Created by Pascal Charpentier on 2023-07-14.
+//
+
+// Exécutable distinct: executionRepartie crée ses processus par fork et exige donc que le processus appelant n'ait
+// qu'un fil, ce que les autres tests (ReservoirFils, ServeurRequetes) ne garantissent pas.
+
+#include "Graphe.h"
+#include "Graphe_algorithmes.h"
+#include "Partitionnement.h"
+#include "gtest/gtest.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include <unistd.h>
+
+TEST(Partitionnement, fennel_equilibre_et_coupe) {
+    const size_t n = 400 ;
+    Graphe g(n) ;
+    for (size_t i = 0; i + 1 < n; ++i) g.ajouterArc(i, i + 1) ;
+    auto partition = partitionnerFennel(g, 4) ;
+    std::vector<size_t> tailles(4, 0) ;
+    for (auto partie: partition.parties) ++ tailles.at(partie) ;
+    for (auto taille: tailles) EXPECT_LE(taille, 111) ;
+    EXPECT_LT(partition.arcsCoupes, 20) ;
+    EXPECT_THROW(partitionnerFennel(g, 0), std::invalid_argument) ;
+}
+
+TEST(Partitionnement, partie_fichier_aller_retour) {
+    Graphe g(4) ;
+    g.ajouterArc(0, 1, 2.5) ;
+    g.ajouterArc(1, 2, 1.0) ;
+    g.ajouterArc(2, 3, 4.0) ;
+    Partition partition {2, {0, 0, 1, 1}, 1} ;
+    auto partie = extrairePartie(g, partition, 0) ;
+    ASSERT_EQ(2, partie.nombreLocaux) ;
+    ASSERT_EQ(3, partie.globaux.size()) ;
+    EXPECT_EQ(2, partie.globaux.at(2)) ;
+    EXPECT_EQ(1, partie.proprietaires.at(0)) ;
+
+    const std::string chemin = ::testing::TempDir() + "partie0.partie" ;
+    ecrirePartie(partie, chemin) ;
+    auto relue = lirePartie<size_t, double>(chemin) ;
+    EXPECT_EQ(partie.globaux, relue.globaux) ;
+    EXPECT_EQ(partie.proprietaires, relue.proprietaires) ;
+    EXPECT_TRUE(relue.graphe.arcExiste(1, 2)) ;
+    EXPECT_EQ(2.5, relue.graphe.enumererVoisins(0).front().poids) ;
+    std::remove(chemin.c_str()) ;
+}
+
+TEST(Partitionnement, partie_fichier_corrompu) {
+    const std::string chemin = ::testing::TempDir() + "corrompue" + std::to_string(::getpid()) + ".partie" ;
+    const uint64_t enorme = uint64_t {1} << 62, maximum = std::numeric_limits<uint64_t>::max() ;
+    const std::vector<std::vector<uint64_t>> contenus {
+        {0, enorme, 0},                 // Trop de sommets locaux pour la taille du fichier
+        {0, 1, maximum, 0, 0},          // Somme des comptes qui déborde
+        {0, 2, 1, 0, 1},                // Tronqué
+        {0, 1, 0, 0, 1, 5, 0},          // Destination hors de la partie
+    } ;
+    for (const auto& contenu: contenus) {
+        {
+            std::ofstream fichier(chemin, std::ios::binary | std::ios::trunc) ;
+            fichier.write(reinterpret_cast<const char*>(contenu.data()),
+                          static_cast<std::streamsize>(contenu.size() * sizeof(uint64_t))) ;
+        }
+        EXPECT_THROW((lirePartie<size_t, double>(chemin)), std::runtime_error) << contenu[1] << ' ' << contenu[2] ;
+    }
+    std::remove(chemin.c_str()) ;
+}
+
+TEST(Partitionnement, execution_repartie_comme_sequentielle) {
+    const size_t n = 500 ;
+    Graphe g(n) ;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t k = 1; k <= 3; ++k) {
+            size_t j = (i * 31 + k * 97) % n ;
+            if (j != i && !g.arcExiste(i, j)) g.ajouterArc(i, j, static_cast<double>((i + k) % 7 + 1)) ;
+        }
+    auto partition = partitionnerFennel(g, 3) ;
+    auto chemins = ecrirePartitions(g, partition, ::testing::TempDir() + "reparti") ;
+
+    EXPECT_EQ(dijkstraFilePrioritaire(g, 5).distances, (cheminsRepartis<size_t, double>(chemins, 5))) ;
+
+    Graphe unitaire(n) ;
+    for (size_t i = 0; i < n; ++i)
+        for (const auto& arc: g.enumererVoisins(i)) unitaire.ajouterArc(i, arc.destination) ;
+    auto attendu = dijkstraFilePrioritaire(unitaire, 5).distances ;
+    auto sauts = largeurRepartie<size_t, double>(chemins, 5) ;
+    ASSERT_EQ(n, sauts.size()) ;
+    for (size_t i = 0; i < n; ++i)
+        if (attendu[i] == TraitsPoids<double>::infini()) EXPECT_EQ(std::numeric_limits<size_t>::max(), sauts[i]) ;
+        else EXPECT_EQ(attendu[i], static_cast<double>(sauts[i])) ;
+
+    EXPECT_THROW((largeurRepartie<size_t, double>(chemins, n + 3)), std::invalid_argument) ;
+    for (const auto& chemin: chemins) std::remove(chemin.c_str()) ;
+}
+
+TEST(Partitionnement, execution_repartie_exige_un_seul_fil) {
+    Graphe g(4) ;
+    g.ajouterArc(0, 1) ;
+    g.ajouterArc(1, 2) ;
+    g.ajouterArc(2, 3) ;
+    auto chemins = ecrirePartitions(g, Partition {2, {0, 0, 1, 1}, 1}, ::testing::TempDir() + "un_fil") ;
+
+    std::mutex verrou ;
+    std::condition_variable reveil ;
+    bool termine = false ;
+    std::thread autre([&]() {
+        std::unique_lock<std::mutex> garde(verrou) ;
+        reveil.wait(garde, [&]() {return termine ; }) ;
+    }) ;
+    EXPECT_THROW((largeurRepartie<size_t, double>(chemins, 0)), std::runtime_error) ;
+    {
+        std::lock_guard<std::mutex> garde(verrou) ;
+        termine = true ;
+    }
+    reveil.notify_one() ;
+    autre.join() ;
+
+    EXPECT_EQ((std::vector<size_t> {0, 1, 2, 3}), (largeurRepartie<size_t, double>(chemins, 0))) ;
+    for (const auto& chemin: chemins) std::remove(chemin.c_str()) ;
+}
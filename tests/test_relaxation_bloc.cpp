@@ -0,0 +1,83 @@
+//
+// Created by Pascal Charpentier on 2023-06-22.
+//
+
+// Compilé une fois avec -mavx2 et une fois avec -mavx512f (voir tests/CMakeLists.txt), pour exercer les versions
+// vectorielles de calculerCandidats que la compilation par défaut n'inclut pas.
+
+#include "RelaxationBloc.h"
+#include "gtest/gtest.h"
+
+#include <random>
+
+#include <sys/mman.h>
+
+namespace {
+
+    bool processeurCompatible() {
+#if defined(__AVX512F__)
+        return __builtin_cpu_supports("avx512f") ;
+#elif defined(__AVX2__)
+        return __builtin_cpu_supports("avx2") ;
+#else
+        return true ;
+#endif
+    }
+
+    template <typename S, typename P>
+    void verifierContreScalaire(P courante, const P* distances, BlocRelaxation<S, P>& bloc) {
+        BlocRelaxation<S, P> attendu = bloc ;
+        calculerCandidatsScalaire(courante, distances, attendu, 0) ;
+        calculerCandidats(courante, distances, bloc) ;
+        for (size_t i = 0; i < bloc.taille; ++i) {
+            EXPECT_EQ(attendu.candidats[i], bloc.candidats[i]) << "i = " << i ;
+            EXPECT_EQ(attendu.ameliore[i], bloc.ameliore[i]) << "i = " << i ;
+        }
+    }
+
+}
+
+TEST(RelaxationBloc, conforme_au_scalaire) {
+    if (!processeurCompatible()) GTEST_SKIP() ;
+    std::mt19937 generateur(5) ;
+    std::uniform_real_distribution<double> reels(0, 10) ;
+    const size_t n = 1000 ;
+    std::vector<double> distancesDouble(n) ;
+    std::vector<float> distancesFloat(n) ;
+    for (size_t i = 0; i < n; ++i) distancesFloat[i] = static_cast<float>(distancesDouble[i] = reels(generateur)) ;
+
+    for (size_t taille: {1, 7, 8, 15, 16, 17, 63, 64}) {
+        BlocRelaxation<size_t, double> blocDouble ;
+        BlocRelaxation<uint32_t, float> blocFloat ;
+        blocDouble.taille = blocFloat.taille = taille ;
+        for (size_t i = 0; i < taille; ++i) {
+            blocDouble.destinations[i] = blocFloat.destinations[i] = static_cast<uint32_t>(generateur() % n) ;
+            blocFloat.poids[i] = static_cast<float>(blocDouble.poids[i] = reels(generateur)) ;
+        }
+        verifierContreScalaire(4.0, distancesDouble.data(), blocDouble) ;
+        verifierContreScalaire(4.0f, distancesFloat.data(), blocFloat) ;
+    }
+}
+
+TEST(RelaxationBloc, destinations_au_dela_de_2_31) {
+    if (!processeurCompatible()) GTEST_SKIP() ;
+
+    // Réserve l'espace d'adressage de 2^32 distances sans l'engager: seules les pages écrites sont allouées.
+    const size_t n = size_t(1) << 32 ;
+    void* memoire = mmap(nullptr, n * sizeof(float), PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0) ;
+    if (memoire == MAP_FAILED) GTEST_SKIP() << "espace d'adressage insuffisant" ;
+    float* distances = static_cast<float*>(memoire) ;
+
+    BlocRelaxation<uint32_t, float> bloc ;
+    bloc.taille = 32 ;
+    for (size_t i = 0; i < bloc.taille; ++i) {
+        bloc.destinations[i] = i % 2 == 0 ? static_cast<uint32_t>((size_t(1) << 31) + i)
+                                          : static_cast<uint32_t>(n - 1 - i) ;
+        distances[bloc.destinations[i]] = i % 4 < 2 ? 1.0f : 100.0f ;
+        bloc.poids[i] = 2.0f ;
+    }
+    verifierContreScalaire(5.0f, distances, bloc) ;
+    for (size_t i = 0; i < bloc.taille; ++i) EXPECT_EQ(i % 4 >= 2, bloc.ameliore[i]) << "i = " << i ;
+    munmap(memoire, n * sizeof(float)) ;
+}